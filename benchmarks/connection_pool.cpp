@@ -0,0 +1,83 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sqlgen/ConnectionPool.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// Measures the throughput of ConnectionPool::acquire() and the release of the
+/// session for an increasing number of threads. Uses a dummy connection, so
+/// that only the overhead of the pool itself is measured.
+///
+/// Usage: sqlgen-benchmark-connection-pool [duration in ms]
+
+namespace benchmark_connection_pool {
+
+struct DummyConnection {
+  DummyConnection(const int _id) : id(_id) {}
+  int id;
+};
+
+double measure(const size_t _num_threads, const size_t _pool_size,
+               const std::chrono::milliseconds _duration) {
+  auto pool = sqlgen::make_connection_pool<DummyConnection>(
+                  sqlgen::ConnectionPoolConfig{.size = _pool_size}, 0)
+                  .value();
+
+  std::atomic<bool> start = false;
+  std::atomic<bool> stop = false;
+  std::atomic<size_t> total = 0;
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < _num_threads; ++i) {
+    threads.emplace_back([&]() {
+      while (!start.load()) {
+      }
+      size_t count = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        const auto sess = pool.acquire(std::chrono::seconds(10));
+        if (sess) {
+          ++count;
+        }
+      }
+      total += count;
+    });
+  }
+
+  start = true;
+  std::this_thread::sleep_for(_duration);
+  stop = true;
+
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  return static_cast<double>(total.load()) /
+         std::chrono::duration<double>(_duration).count();
+}
+
+}  // namespace benchmark_connection_pool
+
+int main(int argc, char* argv[]) {
+  using namespace benchmark_connection_pool;
+
+  const auto duration =
+      std::chrono::milliseconds(argc > 1 ? std::atoi(argv[1]) : 1000);
+
+  std::cout << std::setw(10) << "threads" << std::setw(28)
+            << "acquires/s (pool = threads)" << std::setw(24)
+            << "acquires/s (pool = 8)" << std::endl;
+
+  for (const size_t num_threads : {1, 2, 4, 8, 16, 32, 64}) {
+    const auto ops1 = measure(num_threads, num_threads, duration);
+    const auto ops2 = measure(num_threads, 8, duration);
+    std::cout << std::setw(10) << num_threads << std::fixed
+              << std::setprecision(0) << std::setw(28) << ops1 << std::setw(24)
+              << ops2 << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,118 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sqlgen.hpp>
+#include <sqlgen/postgres.hpp>
+#include <string>
+#include <vector>
+
+/// Measures the throughput of sqlgen::write against a postgres database, in
+/// both the text and the binary COPY format.
+///
+/// Usage: sqlgen-benchmark-postgres-write [number of rows] [repetitions]
+///
+/// The database is configured with the environment variables PGHOST, PGPORT,
+/// PGUSER, PGPASSWORD and PGDATABASE, which default to a local database
+/// called postgres.
+
+namespace benchmark_postgres_write {
+
+struct Measurement {
+  std::string id;
+  int64_t value;
+  double score;
+  std::string name;
+  std::optional<std::string> comment;
+  sqlgen::Timestamp<"%Y-%m-%d %H:%M:%S"> ts;
+};
+
+std::string get_env(const char* _name, const std::string& _default) {
+  const char* value = std::getenv(_name);
+  return value ? std::string(value) : _default;
+}
+
+sqlgen::postgres::Credentials make_credentials() {
+  return sqlgen::postgres::Credentials{
+      .user = get_env("PGUSER", "postgres"),
+      .password = get_env("PGPASSWORD", "password"),
+      .host = get_env("PGHOST", "localhost"),
+      .dbname = get_env("PGDATABASE", "postgres"),
+      .port = std::stoi(get_env("PGPORT", "5432"))};
+}
+
+std::vector<Measurement> make_data(const size_t _num_rows) {
+  std::vector<Measurement> data;
+  data.reserve(_num_rows);
+  for (size_t i = 0; i < _num_rows; ++i) {
+    data.emplace_back(Measurement{
+        .id = "sensor-" + std::to_string(i % 1000),
+        .value = static_cast<int64_t>(i) * 7919,
+        .score = static_cast<double>(i) / 7.0,
+        .name = "measurement number " + std::to_string(i),
+        .comment = i % 3 == 0 ? std::nullopt
+                              : std::make_optional<std::string>(
+                                    "comment\twith a tab " + std::to_string(i)),
+        .ts = "2024-01-01 12:34:56"});
+  }
+  return data;
+}
+
+/// The size of the data in the text format of COPY, which we use as a
+/// reference for both formats, so the numbers are comparable.
+size_t text_size(const std::vector<Measurement>& _data) {
+  std::string buffer;
+  for (const auto& m : _data) {
+    sqlgen::postgres::to_text(m, &buffer);
+  }
+  return buffer.size();
+}
+
+/// Returns the time it took to write _data, in seconds.
+double measure(const std::vector<Measurement>& _data, const bool _binary) {
+  using namespace sqlgen;
+
+  const auto conn = postgres::connect(make_credentials())
+                        .and_then(drop<Measurement> | if_exists)
+                        .value();
+
+  const auto write_data = _binary ? write(std::ref(_data)) | binary
+                                  : write(std::ref(_data));
+
+  const auto start = std::chrono::steady_clock::now();
+  write_data(conn).value();
+  const auto stop = std::chrono::steady_clock::now();
+
+  drop<Measurement>(conn).value();
+
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+}  // namespace benchmark_postgres_write
+
+int main(int argc, char* argv[]) {
+  using namespace benchmark_postgres_write;
+
+  const size_t num_rows = argc > 1 ? std::atoll(argv[1]) : 1000000;
+  const size_t repetitions = argc > 2 ? std::atoll(argv[2]) : 3;
+
+  const auto data = make_data(num_rows);
+  const auto megabytes = static_cast<double>(text_size(data)) / 1e6;
+
+  std::cout << std::setw(10) << "format" << std::setw(16) << "rows/s"
+            << std::setw(12) << "MB/s" << std::endl;
+
+  for (size_t i = 0; i < repetitions; ++i) {
+    for (const bool binary : {false, true}) {
+      const auto seconds = measure(data, binary);
+      std::cout << std::setw(10) << (binary ? "binary" : "text") << std::fixed
+                << std::setprecision(0) << std::setw(16)
+                << static_cast<double>(num_rows) / seconds
+                << std::setprecision(1) << std::setw(12)
+                << megabytes / seconds << std::endl;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <string>
+#include <vector>
+
+/// Measures the throughput of writes and reads against a sqlite database on
+/// disk, once with the default settings and once with the high_throughput
+/// profile of sqlgen::sqlite::Config.
+///
+/// Usage: sqlgen-benchmark-sqlite-profiles [number of rows] [repetitions]
+///
+/// Three workloads are measured: a bulk write of all rows in a single
+/// transaction, inserts of 1000 rows with one transaction each, which is
+/// dominated by the cost of committing, and a read of all rows.
+
+namespace benchmark_sqlite_profiles {
+
+struct Measurement {
+  sqlgen::PrimaryKey<int64_t> id;
+  int64_t value;
+  double score;
+  std::string name;
+};
+
+const char* fname = "sqlgen_benchmark_sqlite_profiles.db";
+
+std::vector<Measurement> make_data(const size_t _num_rows) {
+  std::vector<Measurement> data;
+  data.reserve(_num_rows);
+  for (size_t i = 0; i < _num_rows; ++i) {
+    data.emplace_back(
+        Measurement{.id = static_cast<int64_t>(i),
+                    .value = static_cast<int64_t>(i) * 7919,
+                    .score = static_cast<double>(i) / 8.0,
+                    .name = "measurement number " + std::to_string(i)});
+  }
+  return data;
+}
+
+void remove_files() {
+  for (const auto suffix : {"", "-wal", "-shm", "-journal"}) {
+    std::remove((std::string(fname) + suffix).c_str());
+  }
+}
+
+template <class F>
+double seconds(const F& _f) {
+  const auto start = std::chrono::steady_clock::now();
+  _f();
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+void print(const std::string& _profile, const std::string& _workload,
+           const size_t _num_rows, const double _seconds) {
+  std::cout << std::setw(16) << _profile << std::setw(16) << _workload
+            << std::fixed << std::setprecision(0) << std::setw(16)
+            << static_cast<double>(_num_rows) / _seconds << std::endl;
+}
+
+void measure(const std::string& _profile, const sqlgen::sqlite::Config& _config,
+             const std::vector<Measurement>& _data) {
+  remove_files();
+
+  const auto conn = sqlgen::sqlite::connect(_config).value();
+
+  print(_profile, "bulk write", _data.size(),
+        seconds([&]() { sqlgen::write(conn, _data).value(); }));
+
+  const size_t num_inserts = std::min<size_t>(_data.size(), 1000);
+
+  print(_profile, "single inserts", num_inserts, seconds([&]() {
+          for (size_t i = 0; i < num_inserts; ++i) {
+            const auto row = std::vector<Measurement>({Measurement{
+                .id = static_cast<int64_t>(_data.size() + i),
+                .value = _data[i].value,
+                .score = _data[i].score,
+                .name = _data[i].name}});
+            sqlgen::insert(conn, row).value();
+          }
+        }));
+
+  print(_profile, "read", _data.size() + num_inserts, seconds([&]() {
+          const auto data =
+              sqlgen::read<std::vector<Measurement>>(conn).value();
+          if (data.size() != _data.size() + num_inserts) {
+            std::cerr << "Unexpected number of rows." << std::endl;
+            std::exit(1);
+          }
+        }));
+}
+
+}  // namespace benchmark_sqlite_profiles
+
+int main(int argc, char* argv[]) {
+  using namespace benchmark_sqlite_profiles;
+
+  const size_t num_rows = argc > 1 ? std::atoll(argv[1]) : 1000000;
+  const size_t repetitions = argc > 2 ? std::atoll(argv[2]) : 3;
+
+  const auto data = make_data(num_rows);
+
+  std::cout << std::setw(16) << "profile" << std::setw(16) << "workload"
+            << std::setw(16) << "rows/s" << std::endl;
+
+  for (size_t i = 0; i < repetitions; ++i) {
+    measure("default", sqlgen::sqlite::Config{.fname = fname}, data);
+    measure("high_throughput",
+            sqlgen::sqlite::Config::high_throughput(fname), data);
+  }
+
+  remove_files();
+
+  return 0;
+}
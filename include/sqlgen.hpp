@@ -19,6 +19,7 @@
 #include "sqlgen/aggregations.hpp"
 #include "sqlgen/as.hpp"
 #include "sqlgen/begin_transaction.hpp"
+#include "sqlgen/binary.hpp"
 #include "sqlgen/cache.hpp"
 #include "sqlgen/cascade.hpp"
 #include "sqlgen/col.hpp"
@@ -42,6 +43,7 @@
 #include "sqlgen/order_by.hpp"
 #include "sqlgen/patterns.hpp"
 #include "sqlgen/read.hpp"
+#include "sqlgen/read_each.hpp"
 #include "sqlgen/rollback.hpp"
 #include "sqlgen/select_from.hpp"
 #include "sqlgen/sqlgen_api.hpp"
@@ -0,0 +1,33 @@
+#ifndef SQLGEN_CACHESTATS_HPP_
+#define SQLGEN_CACHESTATS_HPP_
+
+#include <cstddef>
+
+namespace sqlgen {
+
+/// A snapshot of the statistics of a query cache.
+struct CacheStats {
+  /// The number of queries that were served from the cache.
+  size_t hits = 0;
+
+  /// The number of queries that had to be sent to the database.
+  size_t misses = 0;
+
+  /// The number of entries that were removed to make space for new ones.
+  size_t evictions = 0;
+
+  /// The number of entries that were removed, because they expired or a table
+  /// they were read from was written to.
+  size_t invalidations = 0;
+
+  /// The number of entries currently in the cache.
+  size_t size = 0;
+
+  /// The estimated memory used by the entries currently in the cache, in
+  /// bytes.
+  size_t bytes = 0;
+};
+
+}  // namespace sqlgen
+
+#endif
@@ -1,17 +1,21 @@
 #ifndef SQLGEN_CONNECTIONPOOL_HPP_
 #define SQLGEN_CONNECTIONPOOL_HPP_
 
-#include <atomic>
+#include <algorithm>
 #include <chrono>
+#include <functional>
 #include <memory>
-#include <numeric>
-#include <thread>
+#include <optional>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
+#include "ConnectionPoolStats.hpp"
 #include "Ref.hpp"
 #include "Result.hpp"
 #include "Session.hpp"
+#include "internal/ConnectionSlots.hpp"
+#include "internal/PeriodicThread.hpp"
 
 namespace sqlgen {
 
@@ -19,6 +23,37 @@ struct ConnectionPoolConfig {
   size_t size = 4;
   size_t num_attempts = 10;
   size_t wait_time_in_seconds = 1;
+
+  /// How long acquire() waits for a connection to be released before giving
+  /// up. If not set, num_attempts * wait_time_in_seconds is used.
+  std::optional<std::chrono::milliseconds> acquire_timeout = std::nullopt;
+
+  /// The number of connections that are opened right away and never closed
+  /// for being idle. If not set, size is used.
+  std::optional<size_t> min_size = std::nullopt;
+
+  /// The maximum number of connections. Connections beyond min_size are only
+  /// opened when needed. If not set, the larger of size and min_size is used.
+  std::optional<size_t> max_size = std::nullopt;
+
+  /// Connections beyond min_size that have not been used for this long are
+  /// closed in the background. If not set, connections are never closed.
+  std::optional<std::chrono::milliseconds> idle_timeout = std::nullopt;
+
+  /// Whether to check that a connection is still alive before handing it out.
+  /// Broken connections are replaced by new ones. Requires a round-trip to
+  /// the database on every call to acquire().
+  bool health_check_on_acquire = false;
+
+  /// If set, connections that are not in use are checked at this interval in
+  /// the background. Broken connections are replaced by new ones.
+  std::optional<std::chrono::milliseconds> health_check_interval = std::nullopt;
+
+  size_t get_min_size() const { return min_size.value_or(size); }
+
+  size_t get_max_size() const {
+    return max_size.value_or(std::max(size, get_min_size()));
+  }
 };
 
 template <class Connection>
@@ -27,13 +62,42 @@ class ConnectionPool {
 
  public:
   template <class... Args>
-  ConnectionPool(const ConnectionPoolConfig& _config, const Args&... _args) {
-    conns_->reserve(_config.size);
-    for (size_t i = 0; i < _config.size; ++i) {
-      auto conn = Ref<Connection>::make(_args...);
-      auto flag = Ref<std::atomic_flag>::make();
-      flag->clear();
-      conns_->emplace_back(std::make_pair(std::move(conn), std::move(flag)));
+  ConnectionPool(const ConnectionPoolConfig& _config, const Args&... _args)
+      : config_(_config),
+        make_conn_([_args...]() { return Ref<Connection>::make(_args...); }),
+        slots_(Ref<internal::ConnectionSlots>::make(_config.get_max_size())) {
+    if (_config.get_max_size() == 0) {
+      throw std::runtime_error("The maximum size of the pool must be positive.");
+    }
+    if (_config.get_min_size() > _config.get_max_size()) {
+      throw std::runtime_error(
+          "The minimum size of the pool cannot be greater than the maximum "
+          "size.");
+    }
+    conns_->resize(_config.get_max_size());
+    for (size_t i = 0; i < _config.get_max_size(); ++i) {
+      handles_->emplace_back(
+          std::make_shared<internal::SlotHandle>(slots_.ptr(), i));
+    }
+    for (size_t i = 0; i < _config.get_min_size(); ++i) {
+      (*conns_)[i] = make_conn_();
+      slots_->set_open(i, true);
+    }
+    if (_config.idle_timeout) {
+      reaper_ = std::make_shared<internal::PeriodicThread>(
+          std::max(*_config.idle_timeout / 2, std::chrono::milliseconds(1)),
+          [conns = conns_, slots = slots_, min_size = _config.get_min_size(),
+           idle_timeout = *_config.idle_timeout]() {
+            close_idle(conns, slots, min_size, idle_timeout);
+          });
+    }
+    if (_config.health_check_interval) {
+      health_checker_ = std::make_shared<internal::PeriodicThread>(
+          std::max(*_config.health_check_interval,
+                   std::chrono::milliseconds(1)),
+          [conns = conns_, slots = slots_, make_conn = make_conn_]() {
+            check_health(conns, slots, make_conn);
+          });
     }
   }
 
@@ -49,40 +113,148 @@ class ConnectionPool {
 
   ~ConnectionPool() = default;
 
-  /// Acquire a session from the pool. Returns an error if no connections are
-  /// available after several attempts.
+  /// Acquire a session from the pool. If no connection is available, waits
+  /// for one to be released. Returns an error if none was released before the
+  /// acquire_timeout configured in the ConnectionPoolConfig expired.
   Result<Ref<Session<Connection>>> acquire() noexcept {
-    for (size_t att = 0; att < config_.num_attempts; ++att) {
-      if (att != 0) {
-        std::this_thread::sleep_for(
-            std::chrono::seconds(config_.wait_time_in_seconds));
+    return acquire(config_.acquire_timeout.value_or(std::chrono::seconds(
+        config_.num_attempts * config_.wait_time_in_seconds)));
+  }
+
+  /// Acquire a session from the pool. If no connection is available and the
+  /// pool has not reached its maximum size yet, a new connection is opened.
+  /// Otherwise, waits for one to be released. Returns an error if none was
+  /// released before _timeout expired. Waiting threads are served in the order
+  /// they arrived.
+  template <class Rep, class Period>
+  Result<Ref<Session<Connection>>> acquire(
+      const std::chrono::duration<Rep, Period>& _timeout) noexcept {
+    const auto deadline =
+        internal::ConnectionSlots::Clock::now() +
+        std::chrono::duration_cast<internal::ConnectionSlots::Clock::duration>(
+            _timeout);
+    const auto ix = slots_->acquire(deadline);
+    if (!ix) {
+      return error("No available connections in the pool.");
+    }
+    auto& conn = (*conns_)[*ix];
+    if (conn && config_.health_check_on_acquire && !is_alive(**conn)) {
+      close_broken(&conn, *slots_, *ix);
+    }
+    if (!conn) {
+      try {
+        conn = make_conn_();
+      } catch (std::exception& e) {
+        slots_->release(*ix);
+        return error(e.what());
+      }
+      slots_->set_open(*ix, true);
+    }
+    return Ref<Session<Connection>>::make(*conn, (*handles_)[*ix]);
+  }
+
+  /// Get the current number of open connections that are not in use
+  size_t available() const { return slots_->available(); }
+
+  /// Get the maximum number of connections in the pool
+  size_t max_size() const { return slots_->size(); }
+
+  /// Get the current number of open connections in the pool
+  size_t size() const { return slots_->num_open(); }
+
+  /// Get statistics on how long acquire() had to wait for connections.
+  ConnectionPoolStats stats() const { return slots_->stats(); }
+
+ private:
+  /// Checks all connections that are not in use and replaces the broken ones.
+  /// Called by the health checker thread.
+  static void check_health(
+      const Ref<std::vector<std::optional<ConnPtr>>>& _conns,
+      const Ref<internal::ConnectionSlots>& _slots,
+      const std::function<ConnPtr()>& _make_conn) {
+    for (size_t i = 0; i < _slots->size(); ++i) {
+      if (!_slots->is_open(i) || !_slots->try_claim(i)) {
+        continue;
       }
-      for (auto& [conn, flag] : *conns_) {
-        if (!flag->test_and_set()) {
-          return Ref<Session<Connection>>::make(conn, flag);
+      auto& conn = (*_conns)[i];
+      if (conn && !is_alive(**conn)) {
+        close_broken(&conn, *_slots, i);
+        try {
+          conn = _make_conn();
+          _slots->set_open(i, true);
+        } catch (std::exception&) {
+          // The connection will be opened by acquire() once it is needed.
         }
       }
+      _slots->release(i, false);
     }
-    return error("No available connections in the pool.");
   }
 
-  /// Get the current number of available connections
-  size_t available() const {
-    return std::accumulate(conns_->begin(), conns_->end(), 0,
-                           [](const auto _count, const auto& _p) {
-                             return _p.second->test() ? _count : _count + 1;
-                           });
+  /// Closes a connection that has failed the health check. Must only be
+  /// called by the owner of slot _ix.
+  static void close_broken(std::optional<ConnPtr>* _conn,
+                           internal::ConnectionSlots& _slots,
+                           const size_t _ix) noexcept {
+    *_conn = std::nullopt;
+    _slots.set_open(_ix, false);
+    _slots.count_recycled();
   }
 
-  /// Get the total number of connections in the pool
-  size_t size() const { return conns_->size(); }
+  /// Whether the connection is still alive. Connections that do not support
+  /// health checks are always considered alive.
+  static bool is_alive(Connection& _conn) noexcept {
+    if constexpr (requires { _conn.ping(); }) {
+      return static_cast<bool>(_conn.ping());
+    } else {
+      return true;
+    }
+  }
+
+  /// Closes connections beyond _min_size that have not been used for
+  /// _idle_timeout. Called by the reaper thread.
+  static void close_idle(const Ref<std::vector<std::optional<ConnPtr>>>& _conns,
+                         const Ref<internal::ConnectionSlots>& _slots,
+                         const size_t _min_size,
+                         const std::chrono::milliseconds _idle_timeout) {
+    const auto cutoff = internal::ConnectionSlots::Clock::now() - _idle_timeout;
+    while (_slots->num_open() > _min_size) {
+      const auto ix = _slots->acquire_idle(cutoff);
+      if (!ix) {
+        return;
+      }
+      (*_conns)[*ix] = std::nullopt;
+      _slots->set_open(*ix, false);
+      _slots->release(*ix, false);
+    }
+  }
 
  private:
   /// The configuration for the connection pool.
   ConnectionPoolConfig config_;
 
-  /// The underlying connection objects.
-  Ref<std::vector<std::pair<ConnPtr, Ref<std::atomic_flag>>>> conns_;
+  /// Opens a new connection.
+  std::function<ConnPtr()> make_conn_;
+
+  /// The underlying connection objects. Connections that have not been opened
+  /// yet or have been closed for being idle are std::nullopt. An element must
+  /// only be accessed by the owner of the corresponding slot.
+  Ref<std::vector<std::optional<ConnPtr>>> conns_;
+
+  /// Keeps track of which connections are in use and who is waiting for them.
+  Ref<internal::ConnectionSlots> slots_;
+
+  /// A handle for every slot, passed on to the sessions. They keep slots_
+  /// alive, if the sessions outlive the pool.
+  Ref<std::vector<std::shared_ptr<const internal::SlotHandle>>> handles_;
+
+  /// Closes idle connections in the background, if an idle_timeout is
+  /// configured. Shared between all copies of the pool and stopped when the
+  /// last one is destroyed.
+  std::shared_ptr<internal::PeriodicThread> reaper_;
+
+  /// Checks connections that are not in use in the background, if a
+  /// health_check_interval is configured.
+  std::shared_ptr<internal::PeriodicThread> health_checker_;
 };
 
 template <class Connection, class... Args>
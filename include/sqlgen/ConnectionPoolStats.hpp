@@ -0,0 +1,39 @@
+#ifndef SQLGEN_CONNECTIONPOOLSTATS_HPP_
+#define SQLGEN_CONNECTIONPOOLSTATS_HPP_
+
+#include <chrono>
+#include <cstddef>
+
+namespace sqlgen {
+
+/// A snapshot of the statistics of a connection pool.
+struct ConnectionPoolStats {
+  /// The number of times acquire() had to wait for a connection to be
+  /// released, because none was available right away.
+  size_t num_waits = 0;
+
+  /// The number of times acquire() gave up, because the deadline expired.
+  size_t num_timeouts = 0;
+
+  /// The accumulated time spent waiting for connections.
+  std::chrono::nanoseconds total_wait_time{0};
+
+  /// The longest time a single call to acquire() had to wait.
+  std::chrono::nanoseconds max_wait_time{0};
+
+  /// The number of broken connections that were detected by a health check
+  /// and closed, so that they could be replaced by new ones.
+  size_t num_recycled = 0;
+
+  /// The average time acquire() had to wait, if it had to wait at all.
+  std::chrono::nanoseconds mean_wait_time() const noexcept {
+    return num_waits == 0
+               ? std::chrono::nanoseconds(0)
+               : total_wait_time / static_cast<std::chrono::nanoseconds::rep>(
+                                       num_waits);
+  }
+};
+
+}  // namespace sqlgen
+
+#endif
@@ -52,10 +52,62 @@ class Iterator {
 
   void operator++(int) noexcept { ++*this; }
 
+  /// Passes the rows that are left to _f one at a time, stopping at the
+  /// first error. If the underlying iterator can parse the rows itself, they
+  /// are handed over as soon as they are parsed, instead of being collected
+  /// in a batch first. Consumes the iterator.
+  template <class F>
+  Result<Nothing> for_each(const F& _f) {
+    while (true) {
+      for (; ix_ < current_batch_->size(); ++ix_) {
+        auto& res = (*current_batch_)[ix_];
+        if (!res) {
+          return error(res.error().what());
+        }
+        _f(std::move(*res));
+      }
+
+      if (it_->end()) {
+        return Nothing{};
+      }
+
+      if constexpr (requires {
+                      it_->template for_each_as<T>(SQLGEN_BATCH_SIZE, _f);
+                    }) {
+        while (!it_->end()) {
+          const auto res =
+              it_->template for_each_as<T>(SQLGEN_BATCH_SIZE, _f);
+          if (!res) {
+            return res;
+          }
+        }
+        return Nothing{};
+
+      } else {
+        current_batch_ = get_next_batch(it_);
+        ix_ = 0;
+        if (current_batch_->size() == 0) {
+          return Nothing{};
+        }
+      }
+    }
+  }
+
  private:
   static Ref<std::vector<Result<T>>> get_next_batch(
       const Ref<UnderlyingIteratorT>& _it) noexcept {
     using namespace std::ranges::views;
+
+    // Some backends can parse the rows into T themselves, which saves the
+    // detour via strings.
+    if constexpr (requires { _it->template next_as<T>(SQLGEN_BATCH_SIZE); }) {
+      return _it->template next_as<T>(SQLGEN_BATCH_SIZE)
+          .transform([](auto&& _vec) {
+            return Ref<std::vector<Result<T>>>::make(std::move(_vec));
+          })
+          .value_or(Ref<std::vector<Result<T>>>());
+    }
+
     return _it->next(SQLGEN_BATCH_SIZE)
         .transform([](auto str_vec) {
           return Ref<std::vector<Result<T>>>::make(internal::collect::vector(
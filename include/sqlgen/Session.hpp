@@ -1,9 +1,11 @@
 #ifndef SQLGEN_SESSION_HPP_
 #define SQLGEN_SESSION_HPP_
 
-#include <atomic>
 #include <memory>
 #include <optional>
+#include <set>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "Ref.hpp"
@@ -12,6 +14,9 @@
 #include "dynamic/SelectFrom.hpp"
 #include "dynamic/Statement.hpp"
 #include "dynamic/Write.hpp"
+#include "internal/CacheRegistry.hpp"
+#include "internal/ConnectionSlots.hpp"
+#include "internal/execute_statement.hpp"
 #include "internal/iterator_t.hpp"
 
 namespace sqlgen {
@@ -22,45 +27,88 @@ class Session {
   using Connection = _Connection;
   using ConnPtr = Ref<Connection>;
 
-  Session(const Ref<Connection>& _conn, const Ref<std::atomic_flag>& _flag)
-      : conn_(_conn), flag_(_flag.ptr()) {}
+  Session(const Ref<Connection>& _conn,
+          const std::shared_ptr<const internal::SlotHandle>& _slot)
+      : conn_(_conn), slot_(_slot), in_transaction_(false) {}
 
   Session(const Session<Connection>& _other) = delete;
 
   Session(Session<Connection>&& _other)
-      : conn_(std::move(_other.conn_)), flag_(_other.flag_) {
-    _other.flag_.reset();
+      : conn_(std::move(_other.conn_)),
+        slot_(std::move(_other.slot_)),
+        in_transaction_(_other.in_transaction_),
+        written_tables_(std::move(_other.written_tables_)) {
+    _other.slot_.reset();
+    _other.in_transaction_ = false;
+    _other.written_tables_.clear();
   }
 
   ~Session() {
-    if (flag_) {
-      flag_->clear();
+    if (slot_) {
+      slot_->release();
     }
   }
 
-  Result<Nothing> begin_transaction() { return conn_->begin_transaction(); }
+  Result<Nothing> begin_transaction() {
+    return conn_->begin_transaction().transform([&](const auto& _nothing) {
+      in_transaction_ = true;
+      return _nothing;
+    });
+  }
 
-  Result<Nothing> commit() { return conn_->commit(); }
+  Result<Nothing> commit() {
+    const auto res = conn_->commit();
+    in_transaction_ = false;
+    for (const auto& name : written_tables_) {
+      internal::CacheRegistry::instance().invalidate(name);
+    }
+    written_tables_.clear();
+    return res;
+  }
 
   Result<Nothing> execute(const std::string& _sql) {
     return conn_->execute(_sql);
   }
 
+  Result<Nothing> execute_statement(const dynamic::Statement& _stmt)
+    requires internal::can_bind_params<Connection>
+  {
+    return conn_->execute_statement(_stmt);
+  }
+
   template <class ItBegin, class ItEnd>
   Result<Nothing> insert(const dynamic::Insert& _stmt, ItBegin _begin,
                          ItEnd _end) {
     return conn_->insert(_stmt, _begin, _end);
   }
 
+  /// Records that _tablename has been written to. If a transaction has been
+  /// begun on this session, the cached reads of _tablename are invalidated
+  /// when it is committed, otherwise at once.
+  void invalidate_on_commit(const std::string& _tablename) {
+    if (in_transaction_) {
+      written_tables_.insert(_tablename);
+    } else {
+      internal::CacheRegistry::instance().invalidate(_tablename);
+    }
+  }
+
   Session& operator=(const Session& _other) = delete;
 
   Session& operator=(Session&& _other) noexcept {
     if (this == &_other) {
       return *this;
     }
+    if (slot_) {
+      slot_->release();
+    }
     conn_ = std::move(_other.conn_);
-    flag_ = _other.flag_;
-    _other.flag_.reset();
+    slot_ = std::move(_other.slot_);
+    in_transaction_ = _other.in_transaction_;
+    written_tables_ = std::move(_other.written_tables_);
+    _other.slot_.reset();
+    _other.in_transaction_ = false;
+    _other.written_tables_.clear();
     return *this;
   }
 
@@ -69,7 +117,11 @@ class Session {
     return conn_->template read<ContainerType>(_query);
   }
 
-  Result<Nothing> rollback() noexcept { return conn_->rollback(); }
+  Result<Nothing> rollback() noexcept {
+    in_transaction_ = false;
+    written_tables_.clear();
+    return conn_->rollback();
+  }
 
   std::string to_sql(const dynamic::Statement& _stmt) noexcept {
     return conn_->to_sql(_stmt);
@@ -90,9 +142,16 @@ class Session {
   /// The underlying connection object.
   ConnPtr conn_;
 
-  /// The flag corresponding to the object - as long as this is true, we have
-  /// ownership.
-  std::shared_ptr<std::atomic_flag> flag_;
+  /// The slot occupied by the connection - as long as this is set, we have
+  /// ownership of the slot and must release it when we are done.
+  std::shared_ptr<const internal::SlotHandle> slot_;
+
+  /// Whether begin_transaction() has been called without a subsequent
+  /// commit() or rollback().
+  bool in_transaction_;
+
+  /// The tables written to since the transaction began.
+  std::set<std::string> written_tables_;
 };
 
 }  // namespace sqlgen
@@ -1,7 +1,13 @@
 #ifndef SQLGEN_TRANSACTION_HPP_
 #define SQLGEN_TRANSACTION_HPP_
 
+#include <set>
+#include <string>
+#include <utility>
+
 #include "Ref.hpp"
+#include "internal/CacheRegistry.hpp"
+#include "internal/execute_statement.hpp"
 #include "internal/iterator_t.hpp"
 #include "is_connection.hpp"
 
@@ -20,8 +26,10 @@ class Transaction {
 
   Transaction(Transaction&& _other) noexcept
       : conn_(std::move(_other.conn_)),
-        transaction_ended_(_other.transaction_ended_) {
+        transaction_ended_(_other.transaction_ended_),
+        written_tables_(std::move(_other.written_tables_)) {
     _other.transaction_ended_ = true;
+    _other.written_tables_.clear();
   }
 
   ~Transaction() {
@@ -44,10 +52,12 @@ class Transaction {
     if (transaction_ended_) {
       return error("Transaction has already ended, cannot commit.");
     }
-    return conn_->commit().transform([&](const auto& _nothing) {
+    const auto res = conn_->commit().transform([&](const auto& _nothing) {
       transaction_ended_ = true;
       return _nothing;
     });
+    invalidate_written_tables();
+    return res;
   }
 
   const Ref<ConnType>& conn() const noexcept { return conn_; }
@@ -56,12 +66,30 @@ class Transaction {
     return conn_->execute(_sql);
   }
 
+  Result<Nothing> execute_statement(const dynamic::Statement& _stmt)
+    requires internal::can_bind_params<ConnType>
+  {
+    return conn_->execute_statement(_stmt);
+  }
+
   template <class ItBegin, class ItEnd>
   Result<Nothing> insert(const dynamic::Insert& _stmt, ItBegin _begin,
                          ItEnd _end) {
     return conn_->insert(_stmt, _begin, _end);
   }
 
+  /// Records that _tablename has been written to. Other connections only see
+  /// the writes once the transaction is committed, so the cached reads of
+  /// _tablename are invalidated then. If the transaction has already ended,
+  /// they are invalidated at once.
+  void invalidate_on_commit(const std::string& _tablename) {
+    if (transaction_ended_) {
+      internal::CacheRegistry::instance().invalidate(_tablename);
+    } else {
+      written_tables_.insert(_tablename);
+    }
+  }
+
   Transaction& operator=(const Transaction& _other) = delete;
 
   Transaction& operator=(Transaction&& _other) noexcept {
@@ -70,7 +98,9 @@ class Transaction {
     }
     conn_ = _other.conn_;
     transaction_ended_ = _other.transaction_ended_;
+    written_tables_ = std::move(_other.written_tables_);
     _other.transaction_ended_ = true;
+    _other.written_tables_.clear();
     return *this;
   }
 
@@ -83,6 +113,8 @@ class Transaction {
     if (transaction_ended_) {
       return error("Transaction has already ended, cannot roll back.");
     }
+    // Nothing has been written, so the cached reads are still valid.
+    written_tables_.clear();
     return conn_->rollback().transform([&](const auto& _nothing) {
       transaction_ended_ = true;
       return _nothing;
@@ -104,10 +136,24 @@ class Transaction {
     return conn_->write(_begin, _end);
   }
 
+ private:
+  /// Invalidates the cached reads of all tables written to during the
+  /// transaction. This happens even if the commit failed, because we cannot
+  /// tell whether the writes have become visible.
+  void invalidate_written_tables() {
+    for (const auto& name : written_tables_) {
+      internal::CacheRegistry::instance().invalidate(name);
+    }
+    written_tables_.clear();
+  }
+
  private:
   Ref<ConnType> conn_;
 
   bool transaction_ended_;
+
+  /// The tables written to since the transaction began.
+  std::set<std::string> written_tables_;
 };
 
 }  // namespace sqlgen
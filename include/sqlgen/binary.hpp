@@ -0,0 +1,23 @@
+#ifndef SQLGEN_BINARY_HPP_
+#define SQLGEN_BINARY_HPP_
+
+namespace sqlgen {
+
+/// Makes sqlgen::write(...) transfer the data in a binary format, if the
+/// database supports it. For postgres, this means COPY ... (FORMAT binary),
+/// which saves a lot of CPU on both ends, but requires the types of the
+/// columns to match the fields exactly.
+struct Binary {};
+
+template <class OtherType>
+auto operator|(const OtherType& _o, const Binary&) {
+  auto o = _o;
+  o.binary_ = true;
+  return o;
+}
+
+inline const auto binary = Binary{};
+
+}  // namespace sqlgen
+
+#endif
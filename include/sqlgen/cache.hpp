@@ -1,89 +1,141 @@
 #ifndef SQLGEN_CACHE_HPP_
 #define SQLGEN_CACHE_HPP_
 
+#include <chrono>
+#include <exception>
 #include <functional>
 #include <future>
 #include <limits>
-#include <shared_mutex>
+#include <memory>
+#include <optional>
 #include <string>
 #include <type_traits>
-#include <unordered_map>
 #include <utility>
 
+#include "CacheStats.hpp"
 #include "Ref.hpp"
 #include "Result.hpp"
+#include "internal/CacheKey.hpp"
+#include "internal/CacheRegistry.hpp"
+#include "internal/ShardedLRUCache.hpp"
+#include "internal/estimate_size.hpp"
+#include "internal/get_tablenames.hpp"
 #include "internal/query_value_t.hpp"
 #include "is_connection.hpp"
+#include "transpilation/get_tablename.hpp"
 #include "transpilation/to_sql.hpp"
 
 namespace sqlgen {
 
-template <class QueryT, class Connection, size_t _max_size>
+template <class QueryT, class Connection, size_t _max_size,
+          size_t _max_bytes = 0>
   requires is_connection<Connection>
 class CacheImpl {
   static constexpr size_t max_size_ =
       _max_size == 0 ? std::numeric_limits<size_t>::max() : _max_size;
 
  public:
+  using Clock = std::chrono::steady_clock;
+
   using ValueType = internal::query_value_t<QueryT, Ref<Connection>>;
 
-  static Result<ValueType> fetch(const QueryT& _query,
-                                 const Ref<Connection>& _conn) {
-    const auto sql = _conn->to_sql(transpilation::to_sql(_query));
-
-    const auto try_read_from_cache =
-        [&]() -> Result<std::shared_future<Result<ValueType>>> {
-      std::shared_lock read_lock(mtx_);
-      const auto it = cache_.find(sql);
-      if (it != cache_.end()) {
-        return it->second.first;
-      }
-      return error("Could not find the result for the query in the cache.");
-    };
-
-    const auto write_to_cache =
-        [&](const std::shared_future<Result<ValueType>>& _future) {
-          std::unique_lock write_lock(mtx_);
-          cache_[sql] = std::make_pair(_future, counter_++);
-          if (cache_.size() > max_size_) {
-            const auto it =
-                std::min_element(cache_.begin(), cache_.end(),
-                                 [](const auto& _p1, const auto& _p2) {
-                                   return _p1.second.second < _p2.second.second;
-                                 });
-            cache_.erase(it);
-          }
-        };
-
-    return try_read_from_cache()
-        .and_then([](auto _future) { return _future.get(); })
-        .or_else([&](auto&&) -> Result<ValueType> {
-          const std::shared_future<Result<ValueType>> future =
-              std::async(std::launch::async, [&]() { return _query(_conn); });
-          write_to_cache(future);
-          return future.get();
-        });
+  static Result<ValueType> fetch(
+      const QueryT& _query, const Ref<Connection>& _conn,
+      const internal::CacheKey& _key,
+      const std::optional<std::chrono::milliseconds>& _ttl) {
+    const auto now = Clock::now();
+
+    const auto cached = cache_.find(_key, [&](const Entry& _entry) {
+      return !_entry.expires_at || *_entry.expires_at > now;
+    });
+    if (cached) {
+      return cached->result.get();
+    }
+
+    // If another thread has started the same query in the meantime, we wait
+    // for its result instead of sending the query a second time.
+    std::promise<Result<ValueType>> promise;
+    const auto [entry, inserted] = cache_.insert(
+        _key, Entry{.result = promise.get_future().share(),
+                   .expires_at = _ttl ? std::make_optional(now + *_ttl)
+                                      : std::nullopt});
+    if (!inserted) {
+      return entry.result.get();
+    }
+
+    auto res = execute(_query, _conn);
+    promise.set_value(res);
+
+    // Errors are passed on to the threads that are already waiting, but they
+    // are not cached.
+    if (!res) {
+      cache_.erase(_key);
+    } else {
+      cache_.set_cost(_key, internal::estimate_size(*res) +
+                                internal::estimate_size(_key.sql));
+    }
+
+    return res;
+  }
+
+  /// Transpiles the query to generate its key in the cache.
+  static internal::CacheKey make_key(const QueryT& _query,
+                                     const Ref<Connection>& _conn) {
+    const auto stmt = transpilation::to_sql(_query);
+    register_tables(stmt);
+    return internal::CacheKey::from_sql(_conn->to_sql(stmt));
   }
 
   static const auto& cache() { return cache_; }
 
+  static CacheStats stats() { return cache_.stats(); }
+
  private:
-  inline static size_t counter_ = 0;
+  struct Entry {
+    std::shared_future<Result<ValueType>> result;
+
+    /// The point in time after which the entry is no longer valid, if any.
+    std::optional<Clock::time_point> expires_at;
+  };
+
+  /// Makes sure that writes to any of the tables the query reads from clear
+  /// the cache. The tables only depend on the type of the query, so this only
+  /// needs to happen once.
+  static void register_tables(const dynamic::Statement& _stmt) {
+    [[maybe_unused]] static const bool registered = [&]() {
+      internal::CacheRegistry::instance().add(internal::get_tablenames(_stmt),
+                                              []() { cache_.clear(); });
+      return true;
+    }();
+  }
 
-  inline static std::unordered_map<
-      std::string, std::pair<std::shared_future<Result<ValueType>>, size_t>>
-      cache_;
+  static Result<ValueType> execute(const QueryT& _query,
+                                   const Ref<Connection>& _conn) noexcept {
+    try {
+      return _query(_conn);
+    } catch (const std::exception& e) {
+      return error(e.what());
+    }
+  }
 
-  inline static std::shared_mutex mtx_;
+ private:
+  inline static internal::ShardedLRUCache<internal::CacheKey, Entry,
+                                          internal::CacheKey::Hash>
+      cache_{max_size_, _max_bytes};
 };
 
-template <class QueryT, size_t _max_size>
+template <class QueryT, size_t _max_size, size_t _max_bytes = 0>
 struct Cache {
   template <class Connection>
     requires is_connection<Connection>
   auto operator()(const Ref<Connection>& _conn) const {
-    return CacheImpl<QueryT, std::remove_cvref_t<Connection>, _max_size>::fetch(
-        query_, _conn);
+    using Impl = CacheImpl<QueryT, std::remove_cvref_t<Connection>, _max_size,
+                           _max_bytes>;
+    return key_->template apply<Impl>(
+        [&]() { return Impl::make_key(query_, _conn); },
+        [&](const internal::CacheKey& _key) {
+          return Impl::fetch(query_, _conn, _key, ttl_);
+        });
   }
 
   template <class Connection>
@@ -96,23 +148,69 @@ struct Cache {
   template <class Connection>
     requires is_connection<Connection>
   static const auto& cache(const Ref<Connection>& _conn) {
-    return CacheImpl<QueryT, std::remove_cvref_t<Connection>,
-                     _max_size>::cache();
+    return CacheImpl<QueryT, std::remove_cvref_t<Connection>, _max_size,
+                     _max_bytes>::cache();
   }
 
   template <class Connection>
     requires is_connection<Connection>
   static const auto& cache(const Result<Ref<Connection>>& _res) {
-    return CacheImpl<QueryT, std::remove_cvref_t<Connection>,
-                     _max_size>::cache();
+    return CacheImpl<QueryT, std::remove_cvref_t<Connection>, _max_size,
+                     _max_bytes>::cache();
+  }
+
+  template <class Connection>
+    requires is_connection<Connection>
+  static CacheStats stats(const Ref<Connection>& _conn) {
+    return CacheImpl<QueryT, std::remove_cvref_t<Connection>, _max_size,
+                     _max_bytes>::stats();
+  }
+
+  template <class Connection>
+    requires is_connection<Connection>
+  static CacheStats stats(const Result<Ref<Connection>>& _res) {
+    return CacheImpl<QueryT, std::remove_cvref_t<Connection>, _max_size,
+                     _max_bytes>::stats();
   }
 
   QueryT query_;
+
+  /// How long results are served from the cache before the query is sent to
+  /// the database again. If not set, results are kept until they are evicted
+  /// or invalidated.
+  std::optional<std::chrono::milliseconds> ttl_ = std::nullopt;
+
+  /// The key of the query in the cache, generated on first use, so that the
+  /// query does not need to be transpiled on every lookup. Shared by all
+  /// copies, because they all hold the same query.
+  std::shared_ptr<internal::CacheKeyMemo> key_ =
+      std::make_shared<internal::CacheKeyMemo>();
 };
 
-template <size_t _max_size = 2056, class QueryT>
+template <size_t _max_size = 2056, size_t _max_bytes = 0, class QueryT>
 auto cache(const QueryT& _query) {
-  return Cache<std::remove_cvref_t<QueryT>, _max_size>{.query_ = _query};
+  return Cache<std::remove_cvref_t<QueryT>, _max_size, _max_bytes>{
+      .query_ = _query};
+}
+
+template <size_t _max_size = 2056, size_t _max_bytes = 0, class QueryT>
+auto cache(const QueryT& _query, const std::chrono::milliseconds _ttl) {
+  return Cache<std::remove_cvref_t<QueryT>, _max_size, _max_bytes>{
+      .query_ = _query, .ttl_ = _ttl};
+}
+
+/// Removes the results of all cached queries reading from _tablename. This
+/// happens automatically for writes through sqlgen::insert, sqlgen::update,
+/// sqlgen::delete_from and sqlgen::write, so you only need to call it when
+/// the table has been modified by other means.
+inline void invalidate_cache(const std::string& _tablename) {
+  internal::CacheRegistry::instance().invalidate(_tablename);
+}
+
+/// Removes the results of all cached queries reading from the table for T.
+template <class T>
+void invalidate_cache() {
+  invalidate_cache(transpilation::get_tablename<T>());
 }
 
 }  // namespace sqlgen
@@ -5,6 +5,8 @@
 
 #include "Ref.hpp"
 #include "Result.hpp"
+#include "internal/execute_statement.hpp"
+#include "internal/invalidate_cache.hpp"
 #include "is_connection.hpp"
 #include "transpilation/to_delete_from.hpp"
 #include "where.hpp"
@@ -17,9 +19,11 @@ Result<Ref<Connection>> delete_from_impl(const Ref<Connection>& _conn,
                                          const WhereType& _where) {
   const auto query =
       transpilation::to_delete_from<ValueType, WhereType>(_where);
-  return _conn->execute(_conn->to_sql(query)).transform([&](const auto&) {
-    return _conn;
-  });
+  const auto res = internal::execute_statement(_conn, query);
+
+  internal::invalidate_cache(_conn, query.table.name);
+
+  return res.transform([&](const auto&) { return _conn; });
 }
 
 template <class ValueType, class WhereType, class Connection>
@@ -1,6 +1,7 @@
 #ifndef SQLGEN_DYNAMIC_INSERT_HPP_
 #define SQLGEN_DYNAMIC_INSERT_HPP_
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -16,6 +17,10 @@ struct Insert {
 
   /// Holds primary keys and unique columns when or_replace is true.
   std::vector<std::string> constraints;
+
+  /// The number of rows inserted by a single execution of the statement.
+  /// Only supported by sqlite and mysql, ignored by all other databases.
+  size_t num_rows = 1;
 };
 
 }  // namespace sqlgen::dynamic
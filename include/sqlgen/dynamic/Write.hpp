@@ -1,6 +1,7 @@
 #ifndef SQLGEN_DYNAMIC_WRITE_HPP_
 #define SQLGEN_DYNAMIC_WRITE_HPP_
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -11,6 +12,14 @@ namespace sqlgen::dynamic {
 struct Write {
   Table table;
   std::vector<std::string> columns;
+
+  /// Whether the data should be transferred in a binary format. Only
+  /// supported by postgres, ignored by all other databases.
+  bool binary = false;
+
+  /// The number of rows inserted by a single execution of the statement.
+  /// Only supported by sqlite and mysql, ignored by all other databases.
+  size_t num_rows = 1;
 };
 
 }  // namespace sqlgen::dynamic
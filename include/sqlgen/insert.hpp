@@ -12,6 +12,7 @@
 
 #include "internal/batch_size.hpp"
 #include "internal/has_constraint.hpp"
+#include "internal/invalidate_cache.hpp"
 #include "internal/to_str_vec.hpp"
 #include "is_connection.hpp"
 #include "transpilation/to_insert_or_write.hpp"
@@ -30,9 +31,11 @@ Result<Ref<Connection>> insert_impl(const Ref<Connection>& _conn,
   const auto insert_stmt =
       transpilation::to_insert_or_write<T, dynamic::Insert>(_or_replace);
 
-  return _conn->insert(insert_stmt, _begin, _end).transform([&](const auto&) {
-    return _conn;
-  });
+  const auto res = _conn->insert(insert_stmt, _begin, _end);
+
+  internal::invalidate_cache(_conn, insert_stmt.table.name);
+
+  return res.transform([&](const auto&) { return _conn; });
 }
 
 template <class ItBegin, class ItEnd, class Connection>
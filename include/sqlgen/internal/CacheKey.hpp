@@ -0,0 +1,74 @@
+#ifndef SQLGEN_INTERNAL_CACHEKEY_HPP_
+#define SQLGEN_INTERNAL_CACHEKEY_HPP_
+
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <typeinfo>
+
+namespace sqlgen::internal {
+
+/// The key of a cached query: its SQL and the precomputed hash of the SQL,
+/// so that lookups do not need to hash the string again.
+struct CacheKey {
+  struct Hash {
+    size_t operator()(const CacheKey& _key) const noexcept {
+      return _key.hash;
+    }
+  };
+
+  static CacheKey from_sql(std::string _sql) {
+    const auto hash = std::hash<std::string>{}(_sql);
+    return CacheKey{.sql = std::move(_sql), .hash = hash};
+  }
+
+  bool operator==(const CacheKey& _other) const noexcept {
+    return hash == _other.hash && sql == _other.sql;
+  }
+
+  std::string sql;
+  size_t hash;
+};
+
+/// Remembers the key of a cached query, so that it only needs to be
+/// transpiled once. The SQL depends on the dialect of the connection, which
+/// is why the key is tagged with the type it was generated for. Only keys
+/// for the first tag are memoised, which covers the case of a query being
+/// executed on the same kind of connection over and over again.
+class CacheKeyMemo {
+ public:
+  CacheKeyMemo() = default;
+
+  CacheKeyMemo(const CacheKeyMemo& _other) = delete;
+
+  ~CacheKeyMemo() = default;
+
+  /// Calls _f with the memoised key, generating it using _make_key, if
+  /// necessary.
+  template <class Tag, class MakeKeyType, class F>
+  auto apply(const MakeKeyType& _make_key, const F& _f) {
+    std::call_once(once_, [&]() {
+      key_ = _make_key();
+      tag_ = &typeid(Tag);
+    });
+    if (*tag_ == typeid(Tag)) {
+      return _f(*key_);
+    }
+    return _f(_make_key());
+  }
+
+ private:
+  /// Makes sure the key is only generated once.
+  std::once_flag once_;
+
+  /// The memoised key.
+  std::optional<CacheKey> key_;
+
+  /// The type the key was generated for.
+  const std::type_info* tag_ = nullptr;
+};
+
+}  // namespace sqlgen::internal
+
+#endif
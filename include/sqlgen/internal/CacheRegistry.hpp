@@ -0,0 +1,66 @@
+#ifndef SQLGEN_INTERNAL_CACHEREGISTRY_HPP_
+#define SQLGEN_INTERNAL_CACHEREGISTRY_HPP_
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace sqlgen::internal {
+
+/// Keeps track of which query caches hold results read from which tables, so
+/// that writes to a table can invalidate them.
+class CacheRegistry {
+ public:
+  using Callback = std::function<void()>;
+
+  CacheRegistry(const CacheRegistry& _other) = delete;
+
+  ~CacheRegistry() = default;
+
+  /// The process-wide registry.
+  static CacheRegistry& instance() {
+    static CacheRegistry registry;
+    return registry;
+  }
+
+  /// Registers _invalidate to be called whenever one of _tablenames is
+  /// written to.
+  void add(const std::set<std::string>& _tablenames,
+           const Callback& _invalidate) {
+    std::unique_lock lock(mtx_);
+    for (const auto& name : _tablenames) {
+      callbacks_[name].push_back(_invalidate);
+    }
+  }
+
+  /// Invalidates all caches holding results read from _tablename.
+  void invalidate(const std::string& _tablename) const {
+    std::shared_lock lock(mtx_);
+    const auto it = callbacks_.find(_tablename);
+    if (it == callbacks_.end()) {
+      return;
+    }
+    for (const auto& invalidate : it->second) {
+      invalidate();
+    }
+  }
+
+ private:
+  CacheRegistry() = default;
+
+ private:
+  /// Protects callbacks_.
+  mutable std::shared_mutex mtx_;
+
+  /// The callbacks of the caches reading from a table, keyed by the table
+  /// name.
+  std::map<std::string, std::vector<Callback>> callbacks_;
+};
+
+}  // namespace sqlgen::internal
+
+#endif
@@ -0,0 +1,320 @@
+#ifndef SQLGEN_INTERNAL_CONNECTIONSLOTS_HPP_
+#define SQLGEN_INTERNAL_CONNECTIONSLOTS_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "../ConnectionPoolStats.hpp"
+
+namespace sqlgen::internal {
+
+/// Keeps track of which connections in a pool are open and in use and parks
+/// the threads waiting for one in a FIFO queue. Acquiring a free slot is
+/// lock-free. When a slot is released while threads are waiting, it is
+/// handed over directly to the longest waiting thread, so that newcomers
+/// cannot overtake them.
+///
+/// Every slot lives on its own cache line and every thread starts looking for
+/// a free slot at the one it used last, so uncontended acquires only touch a
+/// single cache line instead of all threads fighting over the first few slots.
+class ConnectionSlots {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /// Assumed size of a cache line.
+  static constexpr size_t cache_line_size = 64;
+
+  ConnectionSlots(const size_t _size) : slots_(_size), num_waiting_(0) {
+    for (auto& slot : slots_) {
+      slot.in_use.clear();
+    }
+  }
+
+  ConnectionSlots(const ConnectionSlots& _other) = delete;
+
+  ~ConnectionSlots() = default;
+
+  /// Acquires a free slot, waiting until _deadline if there is none. Slots
+  /// with an open connection are preferred. Returns std::nullopt if the
+  /// deadline expired.
+  std::optional<size_t> acquire(const Clock::time_point _deadline) noexcept {
+    if (num_waiting_.load() == 0) {
+      const auto ix = try_acquire();
+      if (ix) {
+        return ix;
+      }
+    }
+    return wait_for_slot(_deadline);
+  }
+
+  /// Acquires a free slot with an open connection that has not been used
+  /// since _cutoff, without waiting.
+  std::optional<size_t> acquire_idle(const Clock::time_point _cutoff) noexcept {
+    const auto cutoff = _cutoff.time_since_epoch().count();
+    for (size_t i = 0; i < slots_.size(); ++i) {
+      auto& slot = slots_[i];
+      if (!slot.open.load() || slot.in_use.test() ||
+          slot.last_used.load() >= cutoff) {
+        continue;
+      }
+      if (!slot.in_use.test_and_set()) {
+        if (slot.last_used.load() < cutoff) {
+          return i;
+        }
+        release(i, false);
+      }
+    }
+    return std::nullopt;
+  }
+
+  /// The number of slots with an open connection that are currently not in
+  /// use.
+  size_t available() const noexcept {
+    return static_cast<size_t>(
+        std::count_if(slots_.begin(), slots_.end(), [](const auto& _slot) {
+          return _slot.open.load() && !_slot.in_use.test();
+        }));
+  }
+
+  /// Whether there is an open connection in slot _ix.
+  bool is_open(const size_t _ix) const noexcept {
+    return slots_[_ix].open.load();
+  }
+
+  /// Increments the counter for broken connections that have been closed.
+  void count_recycled() noexcept {
+    num_recycled_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// The number of slots with an open connection.
+  size_t num_open() const noexcept {
+    return static_cast<size_t>(
+        std::count_if(slots_.begin(), slots_.end(),
+                      [](const auto& _slot) { return _slot.open.load(); }));
+  }
+
+  /// Returns slot _ix to the pool or hands it over to the first waiter. If
+  /// _used is false, the slot has only been claimed for housekeeping and does
+  /// not count as used for the purpose of closing idle connections.
+  void release(const size_t _ix, const bool _used = true) noexcept {
+    auto& slot = slots_[_ix];
+
+    if (_used) {
+      slot.last_used.store(Clock::now().time_since_epoch().count());
+    }
+
+    if (num_waiting_.load() == 0) {
+      slot.in_use.clear();
+
+      // A thread might have started waiting after we checked, but before it
+      // could see the cleared flag, so we need to check again.
+      if (num_waiting_.load() == 0 || slot.in_use.test_and_set()) {
+        return;
+      }
+    }
+
+    std::lock_guard lock(mtx_);
+    if (waiters_.empty()) {
+      slot.in_use.clear();
+      return;
+    }
+    auto waiter = waiters_.front();
+    waiters_.pop_front();
+    --num_waiting_;
+    waiter->ix = _ix;
+    waiter->cv.notify_one();
+  }
+
+  /// Marks whether there is an open connection in slot _ix. Must only be
+  /// called by the owner of the slot.
+  void set_open(const size_t _ix, const bool _open) noexcept {
+    slots_[_ix].open.store(_open);
+  }
+
+  /// The total number of slots.
+  size_t size() const noexcept { return slots_.size(); }
+
+  /// A snapshot of the wait time statistics.
+  ConnectionPoolStats stats() const noexcept {
+    return ConnectionPoolStats{
+        .num_waits = num_waits_.load(std::memory_order_relaxed),
+        .num_timeouts = num_timeouts_.load(std::memory_order_relaxed),
+        .total_wait_time = std::chrono::nanoseconds(
+            total_wait_ns_.load(std::memory_order_relaxed)),
+        .max_wait_time = std::chrono::nanoseconds(
+            max_wait_ns_.load(std::memory_order_relaxed)),
+        .num_recycled = num_recycled_.load(std::memory_order_relaxed)};
+  }
+
+  /// Claims slot _ix, if it is not in use, without waiting.
+  bool try_claim(const size_t _ix) noexcept {
+    return !slots_[_ix].in_use.test_and_set();
+  }
+
+ private:
+  struct alignas(cache_line_size) Slot {
+    /// Whether the slot is currently in use.
+    std::atomic_flag in_use;
+
+    /// Whether there is an open connection in this slot.
+    std::atomic<bool> open = false;
+
+    /// When the slot was last released, in ticks of the Clock.
+    std::atomic<Clock::rep> last_used = 0;
+  };
+
+  struct Waiter {
+    std::condition_variable cv;
+    std::optional<size_t> ix;
+  };
+
+  void record_wait(const Clock::time_point _start) noexcept {
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        Clock::now() - _start)
+                        .count();
+    num_waits_.fetch_add(1, std::memory_order_relaxed);
+    total_wait_ns_.fetch_add(ns, std::memory_order_relaxed);
+    auto max_ns = max_wait_ns_.load(std::memory_order_relaxed);
+    while (ns > max_ns && !max_wait_ns_.compare_exchange_weak(
+                              max_ns, ns, std::memory_order_relaxed)) {
+    }
+  }
+
+  /// The slot the calling thread should try first in this pool. Initially
+  /// spreads the threads over the slots, afterwards points to the slot the
+  /// thread used last. Every thread keeps the hints for a few pools in a
+  /// small table indexed by the address of the pool, so that threads using
+  /// several pools, like the readers and the writer of a ReadWritePool, do
+  /// not overwrite each other's hints. If two pools map to the same entry,
+  /// the hint is merely reset.
+  size_t& thread_hint() noexcept {
+    struct Hint {
+      const ConnectionSlots* slots = nullptr;
+      size_t value = 0;
+    };
+    thread_local std::array<Hint, 16> hints;
+    auto& hint = hints[(reinterpret_cast<std::uintptr_t>(this) /
+                        alignof(ConnectionSlots)) %
+                       hints.size()];
+    if (hint.slots != this) {
+      hint.slots = this;
+      hint.value = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    }
+    return hint.value;
+  }
+
+  /// Claims _slot, if it is free. Only writes to the slot's cache line if the
+  /// slot looks free, so that scanning busy slots does not invalidate them in
+  /// the caches of other threads.
+  static bool try_claim_slot(Slot& _slot, const bool _must_be_open) noexcept {
+    return (!_must_be_open || _slot.open.load()) && !_slot.in_use.test() &&
+           !_slot.in_use.test_and_set();
+  }
+
+  std::optional<size_t> try_acquire() noexcept {
+    const auto n = slots_.size();
+    auto& hint = thread_hint();
+    const auto start = hint % n;
+    for (const bool must_be_open : {true, false}) {
+      for (size_t k = 0; k < n; ++k) {
+        const auto i = (start + k) % n;
+        if (try_claim_slot(slots_[i], must_be_open)) {
+          hint = i;
+          return i;
+        }
+      }
+    }
+    return std::nullopt;
+  }
+
+  std::optional<size_t> wait_for_slot(
+      const Clock::time_point _deadline) noexcept {
+    const auto start = Clock::now();
+
+    std::unique_lock lock(mtx_);
+
+    ++num_waiting_;
+
+    // Slots released before num_waiting_ was incremented are not handed over,
+    // so we need to look for them ourselves.
+    const auto ix = try_acquire();
+    if (ix) {
+      --num_waiting_;
+      return ix;
+    }
+
+    Waiter waiter;
+    waiters_.push_back(&waiter);
+
+    const bool success = waiter.cv.wait_until(
+        lock, _deadline, [&]() { return waiter.ix.has_value(); });
+
+    if (!success) {
+      waiters_.erase(std::find(waiters_.begin(), waiters_.end(), &waiter));
+      --num_waiting_;
+      num_timeouts_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    record_wait(start);
+
+    return waiter.ix;
+  }
+
+ private:
+  /// The state of the connection at the same index.
+  std::vector<Slot> slots_;
+
+  /// The number of threads in waiters_ or about to be added to it. Read on
+  /// every acquire and release, so it gets a cache line of its own.
+  alignas(cache_line_size) std::atomic<size_t> num_waiting_;
+
+  /// Protects waiters_.
+  alignas(cache_line_size) std::mutex mtx_;
+
+  /// The threads waiting for a connection, in the order they arrived.
+  std::deque<Waiter*> waiters_;
+
+  /// Wait time statistics.
+  std::atomic<size_t> num_waits_ = 0;
+  std::atomic<size_t> num_timeouts_ = 0;
+  std::atomic<std::chrono::nanoseconds::rep> total_wait_ns_ = 0;
+  std::atomic<std::chrono::nanoseconds::rep> max_wait_ns_ = 0;
+
+  /// The number of broken connections that have been closed.
+  std::atomic<size_t> num_recycled_ = 0;
+};
+
+/// Refers to a single slot and keeps the slots alive. Every slot has a handle
+/// of its own, which the sessions using the slot share. That way, acquiring
+/// and releasing a connection only touches the reference count of its own
+/// handle instead of one that all threads contend for.
+class alignas(ConnectionSlots::cache_line_size) SlotHandle {
+ public:
+  SlotHandle(const std::shared_ptr<ConnectionSlots>& _slots, const size_t _ix)
+      : slots_(_slots), ix_(_ix) {}
+
+  /// Returns the slot to the pool or hands it over to the first waiter.
+  void release() const noexcept { slots_->release(ix_); }
+
+ private:
+  /// The slots of the pool.
+  std::shared_ptr<ConnectionSlots> slots_;
+
+  /// The index of the slot.
+  size_t ix_;
+};
+
+}  // namespace sqlgen::internal
+
+#endif
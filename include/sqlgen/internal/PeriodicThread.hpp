@@ -0,0 +1,62 @@
+#ifndef SQLGEN_INTERNAL_PERIODICTHREAD_HPP_
+#define SQLGEN_INTERNAL_PERIODICTHREAD_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace sqlgen::internal {
+
+/// A background thread calling a function at a fixed interval until the
+/// object is destroyed. Used for housekeeping tasks, like closing idle
+/// connections.
+class PeriodicThread {
+ public:
+  PeriodicThread(const std::chrono::milliseconds _interval,
+                 const std::function<void()>& _f)
+      : stop_(false), thread_([this, _interval, _f]() { run(_interval, _f); }) {}
+
+  PeriodicThread(const PeriodicThread& _other) = delete;
+
+  ~PeriodicThread() {
+    {
+      std::lock_guard lock(mtx_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+  }
+
+  PeriodicThread& operator=(const PeriodicThread& _other) = delete;
+
+ private:
+  void run(const std::chrono::milliseconds _interval,
+           const std::function<void()>& _f) {
+    std::unique_lock lock(mtx_);
+    while (!cv_.wait_for(lock, _interval, [this]() { return stop_; })) {
+      lock.unlock();
+      _f();
+      lock.lock();
+    }
+  }
+
+ private:
+  /// Protects stop_.
+  std::mutex mtx_;
+
+  /// Used to wake up the thread when it is supposed to stop.
+  std::condition_variable cv_;
+
+  /// Whether the thread is supposed to stop.
+  bool stop_;
+
+  /// The underlying thread. Note that it is declared last, so it is started
+  /// after all other members have been initialized.
+  std::thread thread_;
+};
+
+}  // namespace sqlgen::internal
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef SQLGEN_INTERNAL_ROWVIEW_HPP_
+#define SQLGEN_INTERNAL_ROWVIEW_HPP_
+
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace sqlgen::internal {
+
+/// A row of a query result, as views into the buffers of the database driver.
+/// NULL values are represented by std::nullopt. The views are only valid
+/// until the driver moves on to the next row or batch, so the row must be
+/// parsed right away.
+using RowView = std::span<const std::optional<std::string_view>>;
+
+}  // namespace sqlgen::internal
+
+#endif
@@ -0,0 +1,249 @@
+#ifndef SQLGEN_INTERNAL_SHARDEDLRUCACHE_HPP_
+#define SQLGEN_INTERNAL_SHARDEDLRUCACHE_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../CacheStats.hpp"
+
+namespace sqlgen::internal {
+
+/// A thread-safe key-value cache with least-recently-used eviction. The keys
+/// are distributed over several shards by their hash, each of which has its
+/// own lock, so that threads looking up different keys rarely block each
+/// other. Lookups, insertions and evictions are O(1).
+///
+/// Every shard evicts its own least recently used entry, once it holds its
+/// share of the maximum size. The eviction is therefore only approximately
+/// LRU with respect to the whole cache. To keep the difference small, a shard
+/// is only added for every min_shard_size entries, so that small caches
+/// consist of a single shard and evict exactly the least recently used entry.
+///
+/// Optionally, every entry can be assigned a cost in bytes. If the total
+/// exceeds the byte budget, least recently used entries are evicted until it
+/// is back under budget. The budget applies to the cache as a whole, so that
+/// a single large entry is not limited to the share of one shard.
+template <class Key, class Value, class Hash = std::hash<Key>>
+class ShardedLRUCache {
+ public:
+  static constexpr size_t max_num_shards = 16;
+
+  /// The minimum number of entries per shard.
+  static constexpr size_t min_shard_size = 64;
+
+  /// _max_size is split as evenly as possible between the shards. A
+  /// _max_bytes of 0 means that there is no byte budget.
+  ShardedLRUCache(const size_t _max_size, const size_t _max_bytes = 0)
+      : shards_(num_shards(_max_size)),
+        max_bytes_(_max_bytes),
+        bytes_(0) {
+    const auto n = shards_.size();
+    for (size_t i = 0; i < n; ++i) {
+      shards_[i].capacity = _max_size / n + (i < _max_size % n ? 1 : 0);
+    }
+  }
+
+  ShardedLRUCache(const ShardedLRUCache& _other) = delete;
+
+  ~ShardedLRUCache() = default;
+
+  /// The total cost of all entries, in bytes.
+  size_t bytes() const noexcept { return bytes_.load(); }
+
+  /// Removes all entries. They are counted as invalidations.
+  void clear() {
+    for (auto& shard : shards_) {
+      std::lock_guard lock(shard.mtx);
+      shard.invalidations += shard.map.size();
+      while (!shard.entries.empty()) {
+        remove(shard, std::prev(shard.entries.end()));
+      }
+    }
+  }
+
+  /// Removes the entry for _key, if there is one.
+  void erase(const Key& _key) {
+    auto& shard = shard_for(_key);
+    std::lock_guard lock(shard.mtx);
+    const auto it = shard.map.find(_key);
+    if (it != shard.map.end()) {
+      remove(shard, it->second);
+    }
+  }
+
+  /// Returns the value for _key, if there is one, and marks it as the most
+  /// recently used.
+  std::optional<Value> find(const Key& _key) {
+    return find(_key, [](const Value&) { return true; });
+  }
+
+  /// Returns the value for _key, if there is one and _is_valid returns true
+  /// for it, and marks it as the most recently used. Entries for which
+  /// _is_valid returns false are removed and counted as invalidations.
+  template <class IsValid>
+  std::optional<Value> find(const Key& _key, const IsValid& _is_valid) {
+    auto& shard = shard_for(_key);
+    std::lock_guard lock(shard.mtx);
+    const auto it = shard.map.find(_key);
+    if (it == shard.map.end()) {
+      ++shard.misses;
+      return std::nullopt;
+    }
+    if (!_is_valid(it->second->value)) {
+      remove(shard, it->second);
+      ++shard.misses;
+      ++shard.invalidations;
+      return std::nullopt;
+    }
+    ++shard.hits;
+    shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+    return it->second->value;
+  }
+
+  /// Inserts _value for _key, unless there already is a value for _key.
+  /// Evicts the least recently used entries, if the shard is full. Returns
+  /// the value in the cache and whether _value was inserted.
+  std::pair<Value, bool> insert(const Key& _key, const Value& _value) {
+    auto& shard = shard_for(_key);
+    std::lock_guard lock(shard.mtx);
+    const auto it = shard.map.find(_key);
+    if (it != shard.map.end()) {
+      shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+      return std::make_pair(it->second->value, false);
+    }
+    shard.entries.emplace_front(Node{.key = _key, .value = _value});
+    shard.map.emplace(_key, shard.entries.begin());
+    while (shard.map.size() > shard.capacity) {
+      remove(shard, std::prev(shard.entries.end()));
+      ++shard.evictions;
+    }
+    return std::make_pair(_value, true);
+  }
+
+  /// Sets the cost of the entry for _key, if there still is one, and evicts
+  /// least recently used entries until the cache is back under its byte
+  /// budget. Entries in other shards are evicted before those in the shard
+  /// of _key, so that the entry for _key is only evicted if it alone exceeds
+  /// the budget.
+  void set_cost(const Key& _key, const size_t _bytes) {
+    const auto ix = shard_ix(_key);
+    {
+      auto& shard = shards_[ix];
+      std::lock_guard lock(shard.mtx);
+      const auto it = shard.map.find(_key);
+      if (it == shard.map.end()) {
+        return;
+      }
+      bytes_ -= it->second->bytes;
+      it->second->bytes = _bytes;
+      bytes_ += _bytes;
+    }
+    if (max_bytes_ == 0) {
+      return;
+    }
+    const auto n = shards_.size();
+    for (size_t k = 1; k <= n && bytes_.load() > max_bytes_; ++k) {
+      auto& shard = shards_[(ix + k) % n];
+      std::lock_guard lock(shard.mtx);
+      while (bytes_.load() > max_bytes_ && !shard.entries.empty()) {
+        remove(shard, std::prev(shard.entries.end()));
+        ++shard.evictions;
+      }
+    }
+  }
+
+  /// The number of entries in the cache.
+  size_t size() const {
+    size_t size = 0;
+    for (auto& shard : shards_) {
+      std::lock_guard lock(shard.mtx);
+      size += shard.map.size();
+    }
+    return size;
+  }
+
+  /// A snapshot of the hit, miss, eviction and invalidation counters.
+  CacheStats stats() const {
+    CacheStats stats;
+    for (auto& shard : shards_) {
+      std::lock_guard lock(shard.mtx);
+      stats.hits += shard.hits;
+      stats.misses += shard.misses;
+      stats.evictions += shard.evictions;
+      stats.invalidations += shard.invalidations;
+      stats.size += shard.map.size();
+    }
+    stats.bytes = bytes_.load();
+    return stats;
+  }
+
+ private:
+  struct Node {
+    Key key;
+    Value value;
+
+    /// The cost of the entry, as set by set_cost(...).
+    size_t bytes = 0;
+  };
+
+  using Entries = std::list<Node>;
+
+  struct alignas(64) Shard {
+    /// Protects all other fields.
+    mutable std::mutex mtx;
+
+    /// The entries, with the most recently used in front.
+    Entries entries;
+
+    /// Maps the keys to their position in entries.
+    std::unordered_map<Key, typename Entries::iterator, Hash> map;
+
+    /// The maximum number of entries in this shard.
+    size_t capacity = 0;
+
+    /// Statistics, only accessed while holding the lock.
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+    size_t invalidations = 0;
+  };
+
+  /// Removes the entry at _it. Must be called while holding the lock of
+  /// _shard.
+  void remove(Shard& _shard, const typename Entries::iterator _it) {
+    bytes_ -= _it->bytes;
+    _shard.map.erase(_it->key);
+    _shard.entries.erase(_it);
+  }
+
+  static size_t num_shards(const size_t _max_size) {
+    return std::clamp<size_t>(_max_size / min_shard_size, 1, max_num_shards);
+  }
+
+  size_t shard_ix(const Key& _key) const {
+    return Hash{}(_key) % shards_.size();
+  }
+
+  Shard& shard_for(const Key& _key) { return shards_[shard_ix(_key)]; }
+
+ private:
+  /// The shards, each holding the keys with the same hash modulo their number.
+  std::vector<Shard> shards_;
+
+  /// The maximum total cost of all entries, or 0 if there is no limit.
+  size_t max_bytes_;
+
+  /// The total cost of all entries.
+  std::atomic<size_t> bytes_;
+};
+
+}  // namespace sqlgen::internal
+
+#endif
@@ -1,3 +1,7 @@
 #ifndef SQLGEN_BATCH_SIZE
 #define SQLGEN_BATCH_SIZE 50000
 #endif
+
+#ifndef SQLGEN_ROWS_PER_INSERT
+#define SQLGEN_ROWS_PER_INSERT 500
+#endif
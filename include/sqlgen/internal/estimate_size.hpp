@@ -0,0 +1,88 @@
+#ifndef SQLGEN_INTERNAL_ESTIMATE_SIZE_HPP_
+#define SQLGEN_INTERNAL_ESTIMATE_SIZE_HPP_
+
+#include <cstddef>
+#include <optional>
+#include <ranges>
+#include <rfl.hpp>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace sqlgen::internal {
+
+template <class T>
+size_t estimate_heap_size(const T& _t);
+
+template <class T>
+struct IsOptional : std::false_type {};
+
+template <class T>
+struct IsOptional<std::optional<T>> : std::true_type {};
+
+/// Wrappers like sqlgen::PrimaryKey or sqlgen::Varchar, which hold their
+/// value in a member returned by reference.
+template <class T>
+concept has_value_ref = requires(const T& _t) { _t.value(); } &&
+                        std::is_lvalue_reference_v<
+                            decltype(std::declval<const T&>().value())>;
+
+/// Estimates the memory allocated on the heap by the string, if it does not
+/// fit into the small string buffer.
+inline size_t estimate_heap_size(const std::string& _str) {
+  const auto begin = reinterpret_cast<const char*>(&_str);
+  const bool is_small =
+      _str.data() >= begin && _str.data() < begin + sizeof(std::string);
+  return is_small ? 0 : _str.capacity() + 1;
+}
+
+/// Estimates the memory allocated on the heap by _t, in bytes, by
+/// recursively iterating over containers and the fields of structs.
+template <class T>
+size_t estimate_heap_size(const T& _t) {
+  using Type = std::remove_cvref_t<T>;
+
+  if constexpr (std::is_arithmetic_v<Type> || std::is_enum_v<Type>) {
+    return 0;
+
+  } else if constexpr (IsOptional<Type>::value) {
+    return _t ? estimate_heap_size(*_t) : 0;
+
+  } else if constexpr (has_value_ref<Type>) {
+    return estimate_heap_size(_t.value());
+
+  } else if constexpr (std::ranges::forward_range<Type>) {
+    using ValueType = std::ranges::range_value_t<Type>;
+    size_t size = 0;
+    size_t num_elements = 0;
+    for (const auto& e : _t) {
+      size += sizeof(ValueType) + estimate_heap_size(e);
+      ++num_elements;
+    }
+    if constexpr (requires { _t.capacity(); }) {
+      size += (_t.capacity() - num_elements) * sizeof(ValueType);
+    }
+    return size;
+
+  } else if constexpr (std::is_class_v<Type> && std::is_aggregate_v<Type>) {
+    return rfl::apply(
+        [](auto... _ptrs) {
+          return (size_t(0) + ... + estimate_heap_size(*_ptrs));
+        },
+        rfl::to_view(_t).values());
+
+  } else {
+    return 0;
+  }
+}
+
+/// Estimates the memory used by _t, in bytes, including the memory allocated
+/// on the heap. Used to keep caches within their byte budget.
+template <class T>
+size_t estimate_size(const T& _t) {
+  return sizeof(std::remove_cvref_t<T>) + estimate_heap_size(_t);
+}
+
+}  // namespace sqlgen::internal
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef SQLGEN_INTERNAL_EXECUTE_STATEMENT_HPP_
+#define SQLGEN_INTERNAL_EXECUTE_STATEMENT_HPP_
+
+#include <concepts>
+
+#include "../Ref.hpp"
+#include "../Result.hpp"
+#include "../dynamic/Statement.hpp"
+
+namespace sqlgen::internal {
+
+/// Connections that can bind the literals in a statement as parameters,
+/// instead of inlining them into the SQL.
+template <class ConnType>
+concept can_bind_params = requires(ConnType c, dynamic::Statement _stmt) {
+  { c.execute_statement(_stmt) } -> std::same_as<Result<Nothing>>;
+};
+
+/// Executes _stmt with its literals bound as parameters, if the connection
+/// supports it, and inlined into the SQL otherwise.
+template <class Connection, class StatementType>
+Result<Nothing> execute_statement(const Ref<Connection>& _conn,
+                                  const StatementType& _stmt) {
+  if constexpr (can_bind_params<Connection>) {
+    return _conn->execute_statement(_stmt);
+  } else {
+    return _conn->execute(_conn->to_sql(_stmt));
+  }
+}
+
+}  // namespace sqlgen::internal
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef SQLGEN_INTERNAL_FOR_EACH_HPP_
+#define SQLGEN_INTERNAL_FOR_EACH_HPP_
+
+#include <utility>
+
+#include "../Result.hpp"
+
+namespace sqlgen::internal {
+
+/// Passes the rows of _range to _f one at a time, stopping at the first
+/// error. Iterators that can hand over their rows without collecting them in
+/// a batch first provide for_each(...) themselves.
+template <class RangeType, class F>
+Result<Nothing> for_each(const RangeType& _range, const F& _f) {
+  auto it = _range.begin();
+  if constexpr (requires { it.for_each(_f); }) {
+    return it.for_each(_f);
+  } else {
+    for (; it != _range.end(); ++it) {
+      auto& res = *it;
+      if (!res) {
+        return error(res.error().what());
+      }
+      _f(std::move(*res));
+    }
+    return Nothing{};
+  }
+}
+
+}  // namespace sqlgen::internal
+
+#endif
@@ -13,20 +13,21 @@
 
 #include "../Result.hpp"
 #include "../parsing/Parser.hpp"
+#include "RowView.hpp"
 #include "call_destructors_where_necessary.hpp"
 
 namespace sqlgen::internal {
 
-template <class ViewType, size_t i>
-void assign_if_field_is_field_i(
-    const std::vector<std::optional<std::string>>& _row, const size_t _i,
-    ViewType* _view, std::optional<Error>* _err) noexcept {
+template <class ViewType, size_t i, class RowType>
+void assign_if_field_is_field_i(const RowType& _row, const size_t _i,
+                                ViewType* _view,
+                                std::optional<Error>* _err) noexcept {
   using FieldType = rfl::tuple_element_t<i, typename ViewType::Fields>;
   using T =
       std::remove_cvref_t<std::remove_pointer_t<typename FieldType::Type>>;
   constexpr auto name = FieldType::name();
   if (_i == i) {
-    auto res = parsing::Parser<T>::read(_row[i]);
+    auto res = parsing::read_value<T>(_row[i]);
     if (!res) {
       std::stringstream stream;
       stream << "Failed to parse field '" << std::string(name)
@@ -38,19 +39,18 @@ void assign_if_field_is_field_i(
   }
 }
 
-template <class ViewType, size_t... is>
+template <class ViewType, class RowType, size_t... is>
 std::optional<Error> assign_to_field_i(
-    const std::vector<std::optional<std::string>>& _row, const size_t _i,
-    ViewType* _view, std::integer_sequence<size_t, is...>) noexcept {
+    const RowType& _row, const size_t _i, ViewType* _view,
+    std::integer_sequence<size_t, is...>) noexcept {
   std::optional<Error> err;
   (assign_if_field_is_field_i<ViewType, is>(_row, _i, _view, &err), ...);
   return err;
 }
 
-template <class ViewType>
+template <class ViewType, class RowType>
 std::pair<std::optional<Error>, size_t> read_into_view(
-    const std::vector<std::optional<std::string>>& _row,
-    ViewType* _view) noexcept {
+    const RowType& _row, ViewType* _view) noexcept {
   constexpr size_t size = ViewType::size();
   if (_row.size() != size) {
     std::stringstream stream;
@@ -68,13 +68,14 @@ std::pair<std::optional<Error>, size_t> read_into_view(
   return std::make_pair(std::nullopt, size);
 }
 
-template <class T>
-Result<T> from_str_vec(
-    const std::vector<std::optional<std::string>>& _str_vec) {
+/// Parses a row into T. _row can be anything that has a size() and whose
+/// elements can be converted to a std::optional<std::string_view>.
+template <class T, class RowType>
+Result<T> from_row(const RowType& _row) {
   alignas(T) unsigned char buf[sizeof(T)]{};
   auto ptr = rfl::internal::ptr_cast<T*>(&buf);
   auto view = rfl::to_view(*ptr);
-  const auto [err, num_fields_assigned] = read_into_view(_str_vec, &view);
+  const auto [err, num_fields_assigned] = read_into_view(_row, &view);
   if (err) [[unlikely]] {
     call_destructors_where_necessary(num_fields_assigned, &view);
     return error(err->what());
@@ -84,6 +85,19 @@ Result<T> from_str_vec(
   return res;
 }
 
+template <class T>
+Result<T> from_str_vec(
+    const std::vector<std::optional<std::string>>& _str_vec) {
+  return from_row<T>(_str_vec);
+}
+
+/// Parses a row straight from the buffers of the database driver, without
+/// copying the values into strings first.
+template <class T>
+Result<T> from_row_view(const RowView& _row) {
+  return from_row<T>(_row);
+}
+
 }  // namespace sqlgen::internal
 
 #endif
@@ -0,0 +1,62 @@
+#ifndef SQLGEN_INTERNAL_GET_TABLENAMES_HPP_
+#define SQLGEN_INTERNAL_GET_TABLENAMES_HPP_
+
+#include <set>
+#include <string>
+#include <type_traits>
+
+#include "../dynamic/Statement.hpp"
+
+namespace sqlgen::internal {
+
+inline void collect_tablenames(const dynamic::SelectFrom& _stmt,
+                               std::set<std::string>* _names);
+
+inline void collect_tablenames(const dynamic::Union& _stmt,
+                               std::set<std::string>* _names) {
+  for (const auto& select : *_stmt.selects) {
+    collect_tablenames(select, _names);
+  }
+}
+
+inline void collect_tablenames(
+    const dynamic::SelectFrom::TableOrQueryType& _table_or_query,
+    std::set<std::string>* _names) {
+  _table_or_query.visit([&](const auto& _t) {
+    using Type = std::remove_cvref_t<decltype(_t)>;
+    if constexpr (std::is_same_v<Type, dynamic::Table>) {
+      _names->insert(_t.name);
+    } else {
+      collect_tablenames(*_t, _names);
+    }
+  });
+}
+
+inline void collect_tablenames(const dynamic::SelectFrom& _stmt,
+                               std::set<std::string>* _names) {
+  collect_tablenames(_stmt.table_or_query, _names);
+  if (_stmt.joins) {
+    for (const auto& join : *_stmt.joins) {
+      collect_tablenames(join.table_or_query, _names);
+    }
+  }
+}
+
+/// Returns the names of all tables a statement reads from, including those in
+/// subqueries and joins. Used to find the cached queries that are affected by
+/// writes to a table.
+inline std::set<std::string> get_tablenames(const dynamic::Statement& _stmt) {
+  std::set<std::string> names;
+  _stmt.visit([&](const auto& _s) {
+    using Type = std::remove_cvref_t<decltype(_s)>;
+    if constexpr (std::is_same_v<Type, dynamic::SelectFrom> ||
+                  std::is_same_v<Type, dynamic::Union>) {
+      collect_tablenames(_s, &names);
+    }
+  });
+  return names;
+}
+
+}  // namespace sqlgen::internal
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef SQLGEN_INTERNAL_INVALIDATE_CACHE_HPP_
+#define SQLGEN_INTERNAL_INVALIDATE_CACHE_HPP_
+
+#include <string>
+
+#include "../Ref.hpp"
+#include "CacheRegistry.hpp"
+
+namespace sqlgen::internal {
+
+/// Connections that keep track of the tables written to in a transaction, so
+/// that the cached reads are only invalidated once the writes are visible to
+/// other connections.
+template <class ConnType>
+concept can_defer_invalidation =
+    requires(ConnType c, std::string _tablename) {
+      c.invalidate_on_commit(_tablename);
+    };
+
+/// Invalidates the cached reads of _tablename after it has been written to
+/// through _conn. Inside a transaction, this happens when it is committed,
+/// otherwise, the write has already been committed and it happens at once.
+template <class Connection>
+void invalidate_cache(const Ref<Connection>& _conn,
+                      const std::string& _tablename) {
+  if constexpr (can_defer_invalidation<Connection>) {
+    _conn->invalidate_on_commit(_tablename);
+  } else {
+    CacheRegistry::instance().invalidate(_tablename);
+  }
+}
+
+}  // namespace sqlgen::internal
+
+#endif
@@ -5,6 +5,7 @@
 #include "../Ref.hpp"
 #include "../Result.hpp"
 #include "../transpilation/value_t.hpp"
+#include "for_each.hpp"
 #include "is_range.hpp"
 #include "iterator_t.hpp"
 
@@ -20,14 +21,11 @@ auto to_container(const Result<IteratorType>& _res) {
     return to_container<Range<IteratorType>>(_res).and_then(
         [](const auto& range) -> Result<ContainerType> {
           ContainerType container;
-          for (auto& res : range) {
-            if (res) {
-              container.emplace_back(std::move(*res));
-            } else {
-              return error(res.error().what());
-            }
-          }
-          return container;
+          return for_each(range,
+                          [&](auto&& _val) {
+                            container.emplace_back(std::move(_val));
+                          })
+              .transform([&](const auto&) { return std::move(container); });
         });
   }
 }
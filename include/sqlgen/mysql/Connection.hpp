@@ -4,9 +4,11 @@
 #include <mysql.h>
 
 #include <memory>
+#include <optional>
 #include <rfl.hpp>
 #include <stdexcept>
 #include <string>
+#include <variant>
 
 #include "../Iterator.hpp"
 #include "../Ref.hpp"
@@ -19,6 +21,7 @@
 #include "../dynamic/Statement.hpp"
 #include "../dynamic/Union.hpp"
 #include "../dynamic/Write.hpp"
+#include "../internal/batch_size.hpp"
 #include "../internal/to_container.hpp"
 #include "../internal/write_or_insert.hpp"
 #include "../is_connection.hpp"
@@ -57,6 +60,9 @@ class SQLGEN_API Connection {
         _end);
   }
 
+  /// Checks whether the connection is still alive by pinging the server.
+  Result<Nothing> ping() noexcept;
+
   template <class ContainerType>
   auto read(const rfl::Variant<dynamic::SelectFrom, dynamic::Union>& _query) {
     using ValueType = transpilation::value_t<ContainerType>;
@@ -81,10 +87,20 @@ class SQLGEN_API Connection {
   Result<Nothing> end_write();
 
  private:
-  /// Actually inserts data based on a prepared statement -
-  /// used by both .insert(...) and .write(...).
+  /// Actually inserts the data, using multi-row INSERT statements that
+  /// insert as many rows at once as the limit on the number of placeholders
+  /// allows, and one more statement for the remaining rows - used by both
+  /// .insert(...) and .write(...). Each execution is a single round trip.
   Result<Nothing> actual_insert(
+      const std::variant<dynamic::Insert, dynamic::Write>& _stmt,
+      const std::vector<std::vector<std::optional<std::string>>>& _data)
+      const noexcept;
+
+  /// Binds the rows of _data starting at _begin to the placeholders of
+  /// _stmt, which inserts _num_rows rows, and executes it.
+  Result<Nothing> insert_rows(
       const std::vector<std::vector<std::optional<std::string>>>& _data,
+      const size_t _begin, const size_t _num_rows,
       MYSQL_STMT* _stmt) const noexcept;
 
   Result<Nothing> insert_impl(
@@ -94,6 +110,11 @@ class SQLGEN_API Connection {
 
   static ConnPtr make_conn(const Credentials& _credentials);
 
+  /// The number of rows a single INSERT statement with _num_cols columns can
+  /// insert without exceeding the limit of 65535 placeholders, but no more
+  /// than SQLGEN_ROWS_PER_INSERT.
+  static size_t max_rows_per_insert(const size_t _num_cols) noexcept;
+
   Result<StmtPtr> prepare_statement(
       const std::variant<dynamic::Insert, dynamic::Write>& _stmt)
       const noexcept;
@@ -105,9 +126,8 @@ class SQLGEN_API Connection {
       const std::vector<std::vector<std::optional<std::string>>>& _data);
 
  private:
-  /// A prepared statement - needed for the read and write operations. Note that
-  /// we have declared it before conn_, meaning it will be destroyed first.
-  StmtPtr stmt_;
+  /// The write operation launched by .start_write(...), if any.
+  std::optional<dynamic::Write> write_;
 
   /// The underlying connection.
   ConnPtr conn_;
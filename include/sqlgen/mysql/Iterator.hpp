@@ -6,10 +6,12 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "../Ref.hpp"
 #include "../Result.hpp"
+#include "../internal/from_str_vec.hpp"
 #include "../sqlgen_api.hpp"
 
 namespace sqlgen::mysql {
@@ -32,7 +34,33 @@ class SQLGEN_API Iterator {
   Result<std::vector<std::vector<std::optional<std::string>>>> next(
       const size_t _batch_size);
 
+  /// Returns the next batch of rows, parsed into T. The values are parsed
+  /// straight from the buffers of the mysql result.
+  template <class T>
+  Result<std::vector<Result<T>>> next_as(const size_t _batch_size) {
+    std::vector<Result<T>> batch;
+    std::vector<std::optional<std::string_view>> row(
+        mysql_num_fields(res_.get()));
+
+    for (size_t i = 0; i < _batch_size; ++i) {
+      const auto res = read_row(&row);
+      if (!res) {
+        return error(res.error().what());
+      }
+      if (end_) {
+        break;
+      }
+      batch.emplace_back(internal::from_row_view<T>(row));
+    }
+
+    return batch;
+  }
+
  private:
+  /// Fetches the next row and points _row to its values. The views are valid
+  /// until the next row is fetched. Sets end_, if there are no rows left.
+  Result<Nothing> read_row(std::vector<std::optional<std::string_view>>* _row);
+
   /// The underlying mysql result.
   ResPtr res_;
 
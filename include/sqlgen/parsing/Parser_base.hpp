@@ -1,11 +1,30 @@
 #ifndef SQLGEN_PARSING_PARSER_BASE_HPP_
 #define SQLGEN_PARSING_PARSER_BASE_HPP_
 
+#include <optional>
+#include <string>
+#include <string_view>
+
 namespace sqlgen::parsing {
 
 template <class T>
 struct Parser;
 
+/// Reads a T from a value returned by the database. Parsers are expected to
+/// take a std::optional<std::string_view>, so that the value can be parsed
+/// straight from the buffers of the database driver. Parsers taking a
+/// std::optional<std::string> are still supported, but the value has to be
+/// copied for them.
+template <class T>
+auto read_value(const std::optional<std::string_view>& _str) noexcept {
+  if constexpr (requires { Parser<T>::read(_str); }) {
+    return Parser<T>::read(_str);
+  } else {
+    return Parser<T>::read(_str ? std::make_optional(std::string(*_str))
+                                : std::optional<std::string>());
+  }
 }
 
+}  // namespace sqlgen::parsing
+
 #endif
@@ -1,9 +1,13 @@
 #ifndef SQLGEN_PARSING_PARSER_DEFAULT_HPP_
 #define SQLGEN_PARSING_PARSER_DEFAULT_HPP_
 
+#include <cctype>
+#include <charconv>
 #include <ranges>
 #include <rfl.hpp>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <type_traits>
 
 #include "../Result.hpp"
@@ -18,9 +22,9 @@ template <class T>
 struct Parser {
   using Type = std::remove_cvref_t<T>;
 
-  static Result<T> read(const std::optional<std::string>& _str) noexcept {
+  static Result<T> read(const std::optional<std::string_view>& _str) noexcept {
     if constexpr (transpilation::has_reflection_method<Type>) {
-      return Parser<std::remove_cvref_t<typename Type::ReflectionType>>::read(
+      return read_value<std::remove_cvref_t<typename Type::ReflectionType>>(
                  _str)
           .transform([](auto&& _t) { return Type(std::move(_t)); });
 
@@ -31,7 +35,12 @@ struct Parser {
 
       try {
         if constexpr (std::is_floating_point_v<Type>) {
-          return static_cast<Type>(std::stod(*_str));
+#ifdef __cpp_lib_to_chars
+          return read_number<double>(*_str).transform(
+              [](const double _d) { return static_cast<Type>(_d); });
+#else
+          return static_cast<Type>(std::stod(std::string(*_str)));
+#endif
 
         } else if constexpr (std::is_same_v<Type, bool>) {
           if (*_str == "t" || *_str == "T" || *_str == "true" ||
@@ -42,13 +51,17 @@ struct Parser {
               *_str == "FALSE") {
             return false;
           }
-          return std::stoi(*_str) != 0;
+          return read_number<long long>(*_str).transform(
+              [](const long long _i) { return _i != 0; });
 
         } else if constexpr (std::is_integral_v<Type>) {
-          return static_cast<Type>(std::stoll(*_str));
+          using IntType = std::conditional_t<std::is_signed_v<Type>, long long,
+                                             unsigned long long>;
+          return read_number<IntType>(*_str).transform(
+              [](const IntType _i) { return static_cast<Type>(_i); });
 
         } else if constexpr (std::is_enum_v<Type>) {
-          if (auto res = rfl::string_to_enum<Type>(*_str)) {
+          if (auto res = rfl::string_to_enum<Type>(std::string(*_str))) {
             return Type{*res};
           } else {
             return error(res.error());
@@ -149,6 +162,30 @@ struct Parser {
       static_assert(rfl::always_false_v<T>, "Unsupported type.");
     }
   }
+
+ private:
+  /// Parses a number without copying _str. Like std::stoll and std::stod,
+  /// leading whitespace and trailing characters are ignored.
+  template <class NumberType>
+  static Result<NumberType> read_number(std::string_view _str) noexcept {
+    while (!_str.empty() &&
+           std::isspace(static_cast<unsigned char>(_str.front()))) {
+      _str.remove_prefix(1);
+    }
+    if (!_str.empty() && _str.front() == '+') {
+      _str.remove_prefix(1);
+    }
+    NumberType value{};
+    const auto res =
+        std::from_chars(_str.data(), _str.data() + _str.size(), value);
+    if (res.ec == std::errc::result_out_of_range) {
+      return error("Value out of range: '" + std::string(_str) + "'.");
+    }
+    if (res.ec != std::errc()) {
+      return error("Could not parse '" + std::string(_str) + "' as a number.");
+    }
+    return value;
+  }
 };
 
 }  // namespace sqlgen::parsing
@@ -2,6 +2,7 @@
 #define SQLGEN_PARSING_PARSER_FOREIGN_KEY_HPP_
 
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "../ForeignKey.hpp"
@@ -16,8 +17,8 @@ template <class T, class _ForeignTableType,
           rfl::internal::StringLiteral _col_name>
 struct Parser<ForeignKey<T, _ForeignTableType, _col_name>> {
   static Result<ForeignKey<T, _ForeignTableType, _col_name>> read(
-      const std::optional<std::string>& _str) noexcept {
-    return Parser<std::remove_cvref_t<T>>::read(_str).transform([](auto&& _t) {
+      const std::optional<std::string_view>& _str) noexcept {
+    return read_value<std::remove_cvref_t<T>>(_str).transform([](auto&& _t) {
       return ForeignKey<T, _ForeignTableType, _col_name>(std::move(_t));
     });
   }
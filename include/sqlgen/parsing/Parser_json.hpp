@@ -3,6 +3,7 @@
 
 #include <rfl/json.hpp>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "../JSON.hpp"
@@ -14,11 +15,12 @@ namespace sqlgen::parsing {
 
 template <class T>
 struct Parser<JSON<T>> {
-  static Result<JSON<T>> read(const std::optional<std::string>& _str) noexcept {
+  static Result<JSON<T>> read(
+      const std::optional<std::string_view>& _str) noexcept {
     if (!_str) {
       return error("NULL value encounted: JSON value cannot be NULL.");
     }
-    return rfl::json::read<T>(*_str).transform(
+    return rfl::json::read<T>(std::string(*_str)).transform(
         [](auto&& _t) { return JSON<T>(std::move(_t)); });
   }
 
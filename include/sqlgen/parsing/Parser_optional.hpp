@@ -3,6 +3,7 @@
 
 #include <optional>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "../Result.hpp"
@@ -14,11 +15,11 @@ namespace sqlgen::parsing {
 template <class T>
 struct Parser<std::optional<T>> {
   static Result<std::optional<T>> read(
-      const std::optional<std::string>& _str) noexcept {
+      const std::optional<std::string_view>& _str) noexcept {
     if (!_str) {
       return std::optional<T>();
     }
-    return Parser<std::remove_cvref_t<T>>::read(_str).transform(
+    return read_value<std::remove_cvref_t<T>>(_str).transform(
         [](auto&& _t) -> std::optional<T> {
           return std::make_optional<T>(std::move(_t));
         });
@@ -2,6 +2,7 @@
 #define SQLGEN_PARSING_PARSER_PRIMARY_KEY_HPP_
 
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "../PrimaryKey.hpp"
@@ -14,8 +15,8 @@ namespace sqlgen::parsing {
 template <class T, bool _auto_incr>
 struct Parser<PrimaryKey<T, _auto_incr>> {
   static Result<PrimaryKey<T, _auto_incr>> read(
-      const std::optional<std::string>& _str) noexcept {
-    return Parser<std::remove_cvref_t<T>>::read(_str).transform(
+      const std::optional<std::string_view>& _str) noexcept {
+    return read_value<std::remove_cvref_t<T>>(_str).transform(
         [](auto&& _t) -> PrimaryKey<T, _auto_incr> {
           return PrimaryKey<T, _auto_incr>(std::move(_t));
         });
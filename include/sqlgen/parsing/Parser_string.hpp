@@ -2,6 +2,7 @@
 #define SQLGEN_PARSING_PARSER_STRING_HPP_
 
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "../Result.hpp"
@@ -14,11 +15,11 @@ namespace sqlgen::parsing {
 template <>
 struct Parser<std::string> {
   static Result<std::string> read(
-      const std::optional<std::string>& _str) noexcept {
+      const std::optional<std::string_view>& _str) noexcept {
     if (!_str) {
       return error("NULL value encounted: String value cannot be NULL.");
     }
-    return *_str;
+    return std::string(*_str);
   }
 
   static std::optional<std::string> write(const std::string& _str) noexcept {
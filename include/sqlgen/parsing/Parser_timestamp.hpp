@@ -2,6 +2,7 @@
 #define SQLGEN_PARSING_PARSER_TIMESTAMP_HPP_
 
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "../Result.hpp"
@@ -17,7 +18,8 @@ template <rfl::internal::StringLiteral _format>
 struct Parser<Timestamp<_format>> {
   using TSType = Timestamp<_format>;
 
-  static Result<TSType> read(const std::optional<std::string>& _str) noexcept {
+  static Result<TSType> read(
+      const std::optional<std::string_view>& _str) noexcept {
     return Parser<std::string>::read(_str).and_then(
         [](auto&& _s) -> Result<TSType> {
           return TSType::from_string(std::move(_s));
@@ -2,6 +2,7 @@
 #define SQLGEN_PARSING_PARSER_UNIQUE_HPP_
 
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "../Result.hpp"
@@ -14,8 +15,8 @@ namespace sqlgen::parsing {
 template <class T>
 struct Parser<Unique<T>> {
   static Result<Unique<T>> read(
-      const std::optional<std::string>& _str) noexcept {
-    return Parser<std::remove_cvref_t<T>>::read(_str).transform(
+      const std::optional<std::string_view>& _str) noexcept {
+    return read_value<std::remove_cvref_t<T>>(_str).transform(
         [](auto&& _t) { return Unique<T>(std::move(_t)); });
   }
 
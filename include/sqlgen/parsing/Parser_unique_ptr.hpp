@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "../Result.hpp"
@@ -14,11 +15,11 @@ namespace sqlgen::parsing {
 template <class T>
 struct Parser<std::unique_ptr<T>> {
   static Result<std::unique_ptr<T>> read(
-      const std::optional<std::string>& _str) noexcept {
+      const std::optional<std::string_view>& _str) noexcept {
     if (!_str) {
       return std::unique_ptr<T>();
     }
-    return Parser<std::remove_cvref_t<T>>::read(_str).transform(
+    return read_value<std::remove_cvref_t<T>>(_str).transform(
         [](auto&& _t) -> std::unique_ptr<T> {
           return std::make_unique<T>(std::move(_t));
         });
@@ -2,6 +2,7 @@
 #define SQLGEN_PARSING_PARSER_VARCHAR_HPP_
 
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "../Result.hpp"
@@ -16,7 +17,7 @@ namespace sqlgen::parsing {
 template <size_t _size>
 struct Parser<Varchar<_size>> {
   static Result<Varchar<_size>> read(
-      const std::optional<std::string>& _str) noexcept {
+      const std::optional<std::string_view>& _str) noexcept {
     return Parser<std::string>::read(_str).and_then(
         [](auto&& _t) -> Result<Varchar<_size>> {
           return Varchar<_size>::make(std::move(_t));
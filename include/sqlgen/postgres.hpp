@@ -3,6 +3,7 @@
 
 #include "../sqlgen.hpp"
 #include "postgres/Credentials.hpp"
+#include "postgres/NotificationListener.hpp"
 #include "postgres/connect.hpp"
 #include "postgres/to_sql.hpp"
 
@@ -0,0 +1,308 @@
+#ifndef SQLGEN_POSTGRES_ASYNCCONNECTION_HPP_
+#define SQLGEN_POSTGRES_ASYNCCONNECTION_HPP_
+
+#ifdef __linux__
+
+#include <libpq-fe.h>
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <rfl.hpp>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "../Ref.hpp"
+#include "../Result.hpp"
+#include "../dynamic/Insert.hpp"
+#include "../dynamic/SelectFrom.hpp"
+#include "../dynamic/Statement.hpp"
+#include "../dynamic/Union.hpp"
+#include "../internal/from_str_vec.hpp"
+#include "../internal/is_range.hpp"
+#include "../internal/to_str_vec.hpp"
+#include "../sqlgen_api.hpp"
+#include "../transpilation/read_to_select_from.hpp"
+#include "../transpilation/to_delete_from.hpp"
+#include "../transpilation/to_insert_or_write.hpp"
+#include "../transpilation/to_update.hpp"
+#include "../transpilation/value_t.hpp"
+#include "Connection.hpp"
+#include "Credentials.hpp"
+#include "EventLoop.hpp"
+#include "Iterator.hpp"
+#include "PostgresV2Connection.hpp"
+#include "PostgresV2Result.hpp"
+#include "PreparedStatements.hpp"
+#include "from_binary.hpp"
+#include "to_sql.hpp"
+
+namespace sqlgen::postgres {
+
+/// A connection that sends its queries without blocking the calling thread.
+/// Instead of the results, every call returns a future, which is fulfilled
+/// once the server has answered. The socket of the connection is watched by
+/// an EventLoop, which can drive any number of connections at once, so that
+/// there does not have to be a thread for every query in flight.
+///
+/// The queries on a single connection are executed one after another, in the
+/// order in which they were submitted, so
+/// execute("BEGIN"), ..., execute("COMMIT") can be used for transactions.
+/// Queries on different connections run concurrently. Unlike Connection,
+/// this can be used from several threads at once.
+class SQLGEN_API AsyncConnection {
+  using Conn = PostgresV2Connection;
+
+  using Rows = std::vector<std::vector<std::optional<std::string>>>;
+
+  /// Called on the thread of the event loop once the query is done.
+  using Callback = std::function<void(Result<PostgresV2Result>)>;
+
+ public:
+  AsyncConnection(const Conn& _conn, const Ref<EventLoop>& _loop,
+                  const Credentials& _credentials = Credentials{});
+
+  AsyncConnection(const AsyncConnection& _other) = delete;
+
+  /// The queries that are still pending fail.
+  ~AsyncConnection();
+
+  static Result<Ref<AsyncConnection>> make(
+      const Credentials& _credentials, const Ref<EventLoop>& _loop) noexcept;
+
+  std::future<Result<Nothing>> execute(const std::string& _sql);
+
+  /// Executes _stmt, with the literals in its conditions and SET clauses
+  /// bound as parameters.
+  std::future<Result<Nothing>> execute_statement(
+      const dynamic::Statement& _stmt);
+
+  /// The rows are converted right away, so they do not need to outlive the
+  /// call. They are inserted one after another using a prepared statement.
+  template <class ItBegin, class ItEnd>
+  std::future<Result<Nothing>> insert(const dynamic::Insert& _stmt,
+                                      ItBegin _begin, ItEnd _end) {
+    Rows rows;
+    for (auto it = _begin; it != _end; ++it) {
+      rows.emplace_back(internal::to_str_vec(*it));
+    }
+    return execute_rows(to_sql_impl(_stmt), std::move(rows),
+                        _stmt.table.name);
+  }
+
+  AsyncConnection& operator=(const AsyncConnection& _other) = delete;
+
+  /// The rows are fetched all at once and parsed on the thread of the event
+  /// loop.
+  template <class ContainerType>
+  std::future<Result<ContainerType>> read(
+      const rfl::Variant<dynamic::SelectFrom, dynamic::Union>& _query) {
+    static_assert(!internal::is_range_v<ContainerType>,
+                  "Asynchronous reads cannot return a Range, because "
+                  "iterating over it would block. Use a container, like "
+                  "std::vector, instead.");
+
+    std::vector<dynamic::Value> values;
+    auto sql =
+        _query.visit([&](const auto& _q) { return to_sql_impl(_q, &values); });
+
+    auto promise = std::make_shared<std::promise<Result<ContainerType>>>();
+    auto future = promise->get_future();
+
+    const bool binary = binary_results_;
+
+    submit(Op{.sql = std::move(sql),
+              .rows = Rows{Connection::to_params(values)},
+              .result_format = binary ? 1 : 0,
+              .callback = [promise, binary](Result<PostgresV2Result> _res) {
+                promise->set_value(_res.and_then([&](const auto& _r) {
+                  return parse_rows<ContainerType>(_r, binary);
+                }));
+              }});
+
+    return future;
+  }
+
+ private:
+  /// A query waiting to be executed.
+  struct Op {
+    std::string sql;
+
+    /// The parameters to execute the prepared statement with, once per row.
+    /// If there are none, _sql is sent as a simple query.
+    std::optional<Rows> rows = std::nullopt;
+
+    /// 0 requests the result in text format, 1 in binary format.
+    int result_format = 0;
+
+    /// Called with the result of the last row or the first error.
+    Callback callback = nullptr;
+  };
+
+  /// Where the query currently being executed is at.
+  enum class Stage { idle, prepare, execute };
+
+  /// Executes the statement prepared for _sql once for every row in _rows
+  /// and invalidates the cached reads of _table, if there is one.
+  std::future<Result<Nothing>> execute_rows(
+      std::string _sql, Rows _rows, const std::optional<std::string>& _table);
+
+  /// Fails all queries that are waiting or in flight with _msg.
+  void fail_all(const std::string& _msg);
+
+  /// Called when the result of the command in flight is complete.
+  void finish_command();
+
+  /// Completes the query in front of the queue with _res and starts the next
+  /// one.
+  void finish_op(Result<PostgresV2Result> _res);
+
+  /// Sends everything libpq has buffered and watches the socket for
+  /// writability, if it could not send all of it.
+  void flush();
+
+  /// Handles the events on the socket.
+  void handle_events(const uint32_t _events);
+
+  /// Fails with the current error message of the connection.
+  Result<PostgresV2Result> make_error() const;
+
+  template <class ContainerType>
+  static Result<ContainerType> parse_rows(const PostgresV2Result& _res,
+                                          const bool _binary) {
+    using T = transpilation::value_t<ContainerType>;
+    const int num_rows = PQntuples(_res.ptr());
+    ContainerType container;
+    if constexpr (requires { container.reserve(size_t()); }) {
+      container.reserve(num_rows);
+    }
+    std::vector<std::optional<std::string_view>> row(PQnfields(_res.ptr()));
+    for (int i = 0; i < num_rows; ++i) {
+      auto val = [&]() -> Result<T> {
+        if (_binary) {
+          return from_binary<T>(_res.ptr(), i);
+        }
+        Iterator::read_row(_res.ptr(), i, &row);
+        return internal::from_row_view<T>(row);
+      }();
+      if (!val) {
+        return error(val.error().what());
+      }
+      container.emplace_back(std::move(*val));
+    }
+    return container;
+  }
+
+  /// Runs _f on the thread of the event loop and waits for it to finish.
+  void run_in_loop(const std::function<void()>& _f);
+
+  /// Sends the next command of the query in front of the queue.
+  void send_command();
+
+  /// Starts the query in front of the queue, if no query is in flight.
+  void start_next();
+
+  /// Queues _op. Can be called from any thread.
+  void submit(Op _op);
+
+ private:
+  /// The underlying connection, in nonblocking mode.
+  Conn conn_;
+
+  /// The event loop watching the socket.
+  Ref<EventLoop> loop_;
+
+  /// The socket of the connection.
+  int socket_;
+
+  /// Whether query results are transferred in binary format.
+  bool binary_results_;
+
+  /// Everything below is only accessed on the thread of the event loop.
+
+  /// The queries waiting to be executed. The one in front is in flight,
+  /// unless stage_ is idle.
+  std::deque<Op> ops_;
+
+  /// Where the query in front of the queue is at.
+  Stage stage_ = Stage::idle;
+
+  /// The row of the query in front of the queue that is being executed.
+  size_t row_ix_ = 0;
+
+  /// The name of the statement prepared for the query in front of the queue.
+  std::string name_;
+
+  /// The last result of the command in flight.
+  std::optional<PostgresV2Result> result_;
+
+  /// The first error of the command in flight.
+  std::optional<std::string> error_;
+
+  /// Set once the connection is broken, after which all queries fail.
+  std::optional<std::string> broken_;
+
+  /// Whether the socket is watched for writability.
+  bool want_write_ = false;
+
+  /// The statements prepared on this connection, keyed by their SQL.
+  PreparedStatements prepared_statements_;
+};
+
+/// The overloads below are found by argument-dependent lookup, so that the
+/// usual query objects, like read<...>, update<...>, delete_from<...>,
+/// insert(...) and exec(...), can be applied to an asynchronous connection.
+/// Instead of a result, they return a future.
+
+template <class ContainerType, class WhereType, class OrderByType,
+          class LimitType, class OffsetType>
+auto read_impl(const Ref<AsyncConnection>& _conn, const WhereType& _where,
+               const LimitType& _limit, const OffsetType& _offset) {
+  using ValueType = transpilation::value_t<ContainerType>;
+  const auto query =
+      transpilation::read_to_select_from<ValueType, WhereType, OrderByType,
+                                         LimitType, OffsetType>(
+          _where, _limit, _offset);
+  return _conn->template read<ContainerType>(query);
+}
+
+template <class ValueType, class SetsType, class WhereType>
+auto update_impl(const Ref<AsyncConnection>& _conn, const SetsType& _sets,
+                 const WhereType& _where) {
+  return _conn->execute_statement(
+      transpilation::to_update<ValueType, SetsType, WhereType>(_sets,
+                                                               _where));
+}
+
+template <class ValueType, class WhereType>
+auto delete_from_impl(const Ref<AsyncConnection>& _conn,
+                      const WhereType& _where) {
+  return _conn->execute_statement(
+      transpilation::to_delete_from<ValueType, WhereType>(_where));
+}
+
+template <class ItBegin, class ItEnd>
+auto insert_impl(const Ref<AsyncConnection>& _conn, ItBegin _begin,
+                 ItEnd _end, bool _or_replace) {
+  using T =
+      std::remove_cvref_t<typename std::iterator_traits<ItBegin>::value_type>;
+  return _conn->insert(
+      transpilation::to_insert_or_write<T, dynamic::Insert>(_or_replace),
+      _begin, _end);
+}
+
+inline auto exec(const Ref<AsyncConnection>& _conn, const std::string& _sql) {
+  return _conn->execute(_sql);
+}
+
+}  // namespace sqlgen::postgres
+
+#endif
+
+#endif
@@ -11,6 +11,7 @@
 #include <vector>
 #include <list>
 
+#include "../CacheStats.hpp"
 #include "../Iterator.hpp"
 #include "../Ref.hpp"
 #include "../Result.hpp"
@@ -21,7 +22,9 @@
 #include "../dynamic/SelectFrom.hpp"
 #include "../dynamic/Statement.hpp"
 #include "../dynamic/Union.hpp"
+#include "../dynamic/Value.hpp"
 #include "../dynamic/Write.hpp"
+#include "../internal/is_range.hpp"
 #include "../internal/iterator_t.hpp"
 #include "../internal/to_container.hpp"
 #include "../internal/write_or_insert.hpp"
@@ -31,8 +34,11 @@
 #include "Credentials.hpp"
 #include "Iterator.hpp"
 #include "PostgresV2Connection.hpp"
+#include "PreparedStatements.hpp"
 #include "exec.hpp"
+#include "to_binary.hpp"
 #include "to_sql.hpp"
+#include "to_text.hpp"
 
 namespace sqlgen::postgres {
 
@@ -52,7 +58,10 @@ class SQLGEN_API Connection {
   using Conn = PostgresV2Connection;
 
  public:
-  Connection(const Conn& _conn);
+  /// Only the options are taken from _credentials, _conn must already be
+  /// connected.
+  Connection(const Conn& _conn,
+             const Credentials& _credentials = Credentials{});
 
   Connection(const Credentials& _credentials);
 
@@ -100,11 +109,18 @@ class SQLGEN_API Connection {
     return _val ? to_param(*_val) : std::nullopt;
   }
 
+  /// Converts a value bound by to_sql_impl(_stmt, &_params).
+  static std::optional<std::string> to_param(const dynamic::Value& _val);
+
   Result<Nothing> execute_params(
       const std::string& _sql,
       const std::vector<std::optional<std::string>>& _params) noexcept;
 
  public:
+  /// Executes _stmt, with the literals in its conditions and SET clauses
+  /// bound as parameters. Statements that only differ in their literals map to
+  /// the same prepared statement.
+  Result<Nothing> execute_statement(const dynamic::Statement& _stmt) noexcept;
 
   template <class ItBegin, class ItEnd>
   Result<Nothing> insert(const dynamic::Insert& _stmt, ItBegin _begin,
@@ -114,11 +130,23 @@ class SQLGEN_API Connection {
         _end);
   }
 
+  /// Checks whether the connection is still alive by sending a trivial query
+  /// to the server.
+  Result<Nothing> ping() noexcept;
+
+  /// A snapshot of the statistics of the prepared statements kept on this
+  /// connection. Every hit is a statement the server did not have to parse
+  /// and plan again.
+  CacheStats prepared_statement_stats() const noexcept {
+    return prepared_statements_.stats();
+  }
+
   template <class ContainerType>
   auto read(const rfl::Variant<dynamic::SelectFrom, dynamic::Union>& _query) {
     using ValueType = transpilation::value_t<ContainerType>;
+    const bool stream = !internal::is_range_v<ContainerType> || stream_ranges_;
     return internal::to_container<ContainerType>(
-        read_impl(_query).transform([](auto&& _it) {
+        read_impl(_query, stream).transform([](auto&& _it) {
           return sqlgen::Iterator<ValueType, postgres::Iterator>(
               std::move(_it));
         }));
@@ -126,20 +154,57 @@ class SQLGEN_API Connection {
 
   Result<Nothing> rollback() noexcept;
 
+  /// Sets the number of rows fetched at once by the reads that follow, see
+  /// Credentials::fetch_size.
+  void set_fetch_size(const size_t _fetch_size) noexcept {
+    fetch_size_ = _fetch_size;
+  }
+
+  /// Sets whether the reads that follow prefetch the next batch of rows, see
+  /// Credentials::prefetch.
+  void set_prefetch(const bool _prefetch) noexcept { prefetch_ = _prefetch; }
+
+  /// Converts all of the values bound by to_sql_impl(_stmt, &_params).
+  static std::vector<std::optional<std::string>> to_params(
+      const std::vector<dynamic::Value>& _values);
+
   std::string to_sql(const dynamic::Statement& _stmt) noexcept;
 
   Result<Nothing> start_write(const dynamic::Write& _stmt);
 
   Result<Nothing> end_write();
 
+  /// Encodes the rows straight into copy_buffer_, which is sent whenever it
+  /// exceeds copy_buffer_size. The rest is sent by end_write().
   template <class ItBegin, class ItEnd>
   Result<Nothing> write(ItBegin _begin, ItEnd _end) {
-    return internal::write_or_insert(
-        [&](const auto& _data) { return write_impl(_data); }, _begin, _end);
+    for (auto it = _begin; it != _end; ++it) {
+      if (binary_write_) {
+        const auto res = to_binary(*it, &copy_buffer_);
+        if (!res) {
+          abort_write(res.error().what());
+          return res;
+        }
+      } else {
+        to_text(*it, &copy_buffer_);
+      }
+      if (copy_buffer_.size() >= copy_buffer_size) {
+        const auto res = flush_copy_buffer();
+        if (!res) {
+          return res;
+        }
+      }
+    }
+    return Nothing{};
   }
 
   std::list<Notification> get_notifications() noexcept;
 
+  /// Appends the pending notifications to _notifications, which can be
+  /// reused between calls to save the allocations. Returns the number of
+  /// notifications appended.
+  size_t get_notifications(std::vector<Notification>* _notifications) noexcept;
+
   rfl::Result<Nothing> listen(const std::string& channel) noexcept;
 
   rfl::Result<Nothing> unlisten(const std:: string& channel) noexcept;
@@ -148,25 +213,86 @@ class SQLGEN_API Connection {
 
   bool consume_input() noexcept;
 
+  /// Whether s can be used as the name of a channel for LISTEN/NOTIFY.
+  static bool is_valid_channel_name(const std::string& s) noexcept;
+
  private:
+  /// Cancels the COPY operation in progress, so that none of the rows are
+  /// written, and discards its result.
+  void abort_write(const std::string& _msg) noexcept;
+
+  /// Sends the content of copy_buffer_ to postgres and clears it.
+  Result<Nothing> flush_copy_buffer() noexcept;
+
   Result<Nothing> insert_impl(
       const dynamic::Insert& _stmt,
       const std::vector<std::vector<std::optional<std::string>>>&
           _data) noexcept;
 
-  Result<Ref<Iterator>> read_impl(
-      const rfl::Variant<dynamic::SelectFrom, dynamic::Union>& _query);
+  /// Forgets about the statement prepared for _sql, if _res says that it no
+  /// longer exists on the server, for instance after a DISCARD ALL.
+  void invalidate_if_missing(const std::string& _sql,
+                             const PGresult* _res) noexcept;
 
-  std::string to_buffer(
-      const std::vector<std::optional<std::string>>& _line) const noexcept;
+#ifdef LIBPQ_HAS_PIPELINING
+  /// Sends everything libpq has buffered to the server, reading the results
+  /// the server sends in the meantime, so that neither side blocks the other.
+  /// Must only be called in nonblocking mode.
+  Result<Nothing> flush_pipeline() noexcept;
+#endif
 
-  Result<Nothing> write_impl(
-      const std::vector<std::vector<std::optional<std::string>>>& _data);
+  /// Executes the statement prepared for _sql once for every row in _data. If
+  /// libpq supports it, the rows are sent in pipeline mode, so that we do not
+  /// have to wait for a round trip after every row.
+  Result<Nothing> insert_rows(
+      const std::string& _sql, const std::string& _name,
+      const std::vector<std::vector<std::optional<std::string>>>&
+          _data) noexcept;
 
-  bool is_valid_channel_name(const std::string& s) const noexcept;
+  /// Returns the name of the statement prepared for _sql, preparing it, if
+  /// it is not in the cache. If caching is disabled, the unnamed statement is
+  /// used.
+  Result<std::string> prepare(const std::string& _sql,
+                              const size_t _num_params) noexcept;
+
+  /// Reads through a cursor, unless _stream is set, see
+  /// Credentials::stream_ranges.
+  Result<Ref<Iterator>> read_impl(
+      const rfl::Variant<dynamic::SelectFrom, dynamic::Union>& _query,
+      const bool _stream);
 
  private:
+  /// The size at which copy_buffer_ is sent to postgres.
+  static constexpr size_t copy_buffer_size = 1 << 20;
+
+  /// The maximum number of rows sent in pipeline mode before we wait for
+  /// their results. Keeps the results the server has to buffer small.
+  static constexpr size_t pipeline_depth = 1000;
+
   Conn conn_;
+
+  /// Whether query results are transferred in binary format.
+  bool binary_results_;
+
+  /// The number of rows fetched at once by reads, 0 meaning
+  /// SQLGEN_BATCH_SIZE.
+  size_t fetch_size_;
+
+  /// Whether reads request the next batch while the current one is parsed.
+  bool prefetch_;
+
+  /// Whether reads into a Range are streamed instead of using a cursor.
+  bool stream_ranges_;
+
+  /// Whether the COPY operation in progress uses the binary format.
+  bool binary_write_ = false;
+
+  /// The statements prepared on this connection, keyed by their SQL.
+  PreparedStatements prepared_statements_;
+
+  /// Collects the rows of a COPY operation, so they can be sent in large
+  /// chunks. Keeps its capacity between operations.
+  std::string copy_buffer_;
 };
 
 }  // namespace sqlgen::postgres
@@ -1,6 +1,7 @@
 #ifndef SQLGEN_POSTGRES_CREDENTIALS_HPP_
 #define SQLGEN_POSTGRES_CREDENTIALS_HPP_
 
+#include <cstddef>
 #include <functional>
 #include <string>
 
@@ -14,6 +15,37 @@ struct Credentials {
   int port = 5432;
   std::function<void(const char*)> notice_handler;
 
+  /// Whether query results should be transferred in binary format and
+  /// decoded straight into the fields of the structs, instead of being sent
+  /// as text and parsed. This saves a lot of CPU for numeric columns. Columns
+  /// of type NUMERIC are converted to floating point or integer fields, and
+  /// BYTEA columns are read as the raw bytes.
+  bool binary_results = false;
+
+  /// The maximum number of prepared statements kept on each connection.
+  /// Inserts and parameterized queries are prepared once per connection and
+  /// then reused, so the server does not have to parse and plan them again.
+  /// The least recently used statements are deallocated, when the limit is
+  /// reached. Set this to 0 to prepare the statements every time.
+  size_t max_prepared_statements = 64;
+
+  /// The number of rows fetched from the server at once, when iterating over
+  /// the result of a read. 0 means SQLGEN_BATCH_SIZE. Larger batches need
+  /// fewer round trips, smaller ones less memory.
+  size_t fetch_size = 0;
+
+  /// Whether the next batch of rows is requested from the server while the
+  /// current one is being parsed, so that the network latency overlaps with
+  /// the parsing. While iterating over a Range, the connection must then not
+  /// be used for anything else.
+  bool prefetch = false;
+
+  /// Reads into containers, like std::vector, are streamed straight from the
+  /// query, without the round trips needed to set up a cursor. Reads into a
+  /// Range use a cursor, unless this is set, because a streamed query keeps
+  /// the connection busy until all of its rows have been read.
+  bool stream_ranges = false;
+
   std::string to_str() const {
     return "postgresql://" + user + ":" + password + "@" + host + ":" +
            std::to_string(port) + "/" + dbname;
@@ -0,0 +1,107 @@
+#ifndef SQLGEN_POSTGRES_EVENTLOOP_HPP_
+#define SQLGEN_POSTGRES_EVENTLOOP_HPP_
+
+#ifdef __linux__
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../Ref.hpp"
+#include "../Result.hpp"
+#include "../sqlgen_api.hpp"
+
+namespace sqlgen::postgres {
+
+/// A single background thread waiting for events on any number of sockets
+/// using epoll. Used to drive many asynchronous connections at once without
+/// needing a thread for each of them.
+///
+/// The handlers and the tasks passed to post(...) are all run on the thread
+/// of the event loop, so state that is only touched by them does not need to
+/// be protected by a lock. They must never block.
+class SQLGEN_API EventLoop {
+ public:
+  /// Called with the epoll events that occurred on the socket.
+  using Handler = std::function<void(uint32_t)>;
+
+  using Task = std::function<void()>;
+
+  EventLoop();
+
+  EventLoop(const EventLoop& _other) = delete;
+
+  /// Stops the thread. Tasks that have been posted but not run yet are
+  /// discarded. Must not be called on the thread of the event loop.
+  ~EventLoop();
+
+  static Result<Ref<EventLoop>> make() noexcept;
+
+  /// Starts watching _fd for _events, calling _handler whenever one of them
+  /// occurs. Must be called on the thread of the event loop.
+  Result<Nothing> add(const int _fd, const uint32_t _events,
+                      const Handler& _handler) noexcept;
+
+  /// Whether the calling thread is the thread of the event loop.
+  bool in_loop_thread() const noexcept {
+    return std::this_thread::get_id() == thread_.get_id();
+  }
+
+  /// Changes the events _fd is watched for. Must be called on the thread of
+  /// the event loop.
+  Result<Nothing> modify(const int _fd, const uint32_t _events) noexcept;
+
+  EventLoop& operator=(const EventLoop& _other) = delete;
+
+  /// Runs _task on the thread of the event loop. Can be called from any
+  /// thread.
+  void post(const Task& _task);
+
+  /// Stops watching _fd. Must be called on the thread of the event loop.
+  void remove(const int _fd) noexcept;
+
+ private:
+  void run();
+
+  /// Runs the tasks that have been posted since the last call.
+  void run_tasks();
+
+  /// Wakes the thread up, if it is waiting for events.
+  void wake_up() noexcept;
+
+ private:
+  /// The epoll instance.
+  int epoll_fd_;
+
+  /// An eventfd used to wake the thread up when tasks are posted or the
+  /// event loop is destroyed.
+  int wake_fd_;
+
+  /// Protects tasks_.
+  std::mutex mtx_;
+
+  /// The tasks waiting to be run on the thread of the event loop.
+  std::vector<Task> tasks_;
+
+  /// Whether the thread is supposed to stop.
+  std::atomic<bool> stop_;
+
+  /// The handlers of the watched sockets. Only accessed on the thread of the
+  /// event loop. Held by pointer, so that a handler can remove itself.
+  std::unordered_map<int, std::shared_ptr<Handler>> handlers_;
+
+  /// The underlying thread. It is started at the end of the constructor,
+  /// once the epoll instance has been set up.
+  std::thread thread_;
+};
+
+}  // namespace sqlgen::postgres
+
+#endif
+
+#endif
@@ -3,25 +3,52 @@
 
 #include <libpq-fe.h>
 
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "../Ref.hpp"
 #include "../Result.hpp"
+#include "../internal/from_str_vec.hpp"
 #include "../internal/random.hpp"
 #include "../sqlgen_api.hpp"
 #include "PostgresV2Connection.hpp"
 #include "PostgresV2Result.hpp"
+#include "from_binary.hpp"
 
 namespace sqlgen::postgres {
 
+/// How the rows of a read are retrieved from the server.
+struct IteratorOptions {
+  /// Whether the rows are transferred in binary format.
+  bool binary_results = false;
+
+  /// The number of rows fetched at once, 0 meaning that the batch size
+  /// requested by the caller of next(...) is used.
+  size_t fetch_size = 0;
+
+  /// Whether the next batch is requested from the server as soon as the
+  /// current one has been received. Only applies to cursors.
+  bool prefetch = false;
+
+  /// Whether the rows are fetched through a server-side cursor. Otherwise,
+  /// the query is sent as it is and the rows are streamed in chunks, which
+  /// saves the round trips for setting up the cursor, but keeps the
+  /// connection busy until all of the rows have been read.
+  bool use_cursor = true;
+};
+
 class SQLGEN_API Iterator {
   using Conn = PostgresV2Connection;
 
  public:
-  Iterator(const std::string& _sql, const Conn& _conn);
+  /// _params are bound to the placeholders in _sql.
+  Iterator(const std::string& _sql, const Conn& _conn,
+           const std::vector<std::optional<std::string>>& _params = {},
+           const IteratorOptions& _options = IteratorOptions{});
 
   Iterator(const Iterator& _other) = delete;
 
@@ -38,27 +65,154 @@ class SQLGEN_API Iterator {
   Result<std::vector<std::vector<std::optional<std::string>>>> next(
       const size_t _batch_size);
 
+  /// Returns the next batch of rows, parsed into T. The values are parsed
+  /// straight from the buffers of the PGresult. If the iterator was created
+  /// with binary_results, the rows are transferred in binary format and
+  /// decoded straight into the fields of T.
+  template <class T>
+  Result<std::vector<Result<T>>> next_as(const size_t _batch_size) {
+    if (end()) {
+      return error("End is reached.");
+    }
+
+    return fetch(_batch_size, binary_results_ ? 1 : 0)
+        .transform([this](auto&& _results) {
+          std::vector<Result<T>> vec;
+          vec.reserve(count_rows(_results));
+          parse_rows<T>(_results, [&](Result<T>&& _val) {
+            vec.emplace_back(std::move(_val));
+            return true;
+          });
+          if (vec.size() == 0) {
+            shutdown();
+          }
+          return vec;
+        });
+  }
+
+  /// Parses the next batch of rows into T and passes them to _f one at a
+  /// time, without collecting them. Stops at the first row that cannot be
+  /// parsed.
+  template <class T, class F>
+  Result<Nothing> for_each_as(const size_t _batch_size, const F& _f) {
+    if (end()) {
+      return error("End is reached.");
+    }
+
+    return fetch(_batch_size, binary_results_ ? 1 : 0)
+        .and_then([&](auto&& _results) -> Result<Nothing> {
+          std::optional<std::string> err;
+          parse_rows<T>(_results, [&](Result<T>&& _val) {
+            if (!_val) {
+              err = _val.error().what();
+              return false;
+            }
+            _f(std::move(*_val));
+            return true;
+          });
+          if (err) {
+            return error(*err);
+          }
+          if (count_rows(_results) == 0) {
+            shutdown();
+          }
+          return Nothing{};
+        });
+  }
+
   Iterator& operator=(const Iterator& _other) = delete;
 
   Iterator& operator=(Iterator&& _other) noexcept;
 
-  static rfl::Result<Ref<Iterator>> make(const std::string& _sql,
-                                         const Conn& _conn) noexcept {
+  /// Points _row to the values of row _i of _res.
+  static void read_row(PGresult* _res, const int _i,
+                       std::vector<std::optional<std::string_view>>* _row);
+
+  static rfl::Result<Ref<Iterator>> make(
+      const std::string& _sql, const Conn& _conn,
+      const std::vector<std::optional<std::string>>& _params = {},
+      const IteratorOptions& _options = IteratorOptions{}) noexcept {
     try {
-      return Ref<Iterator>::make(_sql, _conn);
+      return Ref<Iterator>::make(_sql, _conn, _params, _options);
     } catch (const std::exception& e) {
       return error(e.what());
     }
   }
 
  private:
+  /// The total number of rows in _results.
+  static size_t count_rows(const std::vector<PostgresV2Result>& _results);
+
+  /// Parses the rows in _results into T and passes them to _f, until _f
+  /// returns false.
+  template <class T, class F>
+  void parse_rows(const std::vector<PostgresV2Result>& _results,
+                  const F& _f) const {
+    for (const auto& res : _results) {
+      const int num_rows = PQntuples(res.ptr());
+      if (binary_results_) {
+        for (int i = 0; i < num_rows; ++i) {
+          if (!_f(from_binary<T>(res.ptr(), i))) {
+            return;
+          }
+        }
+      } else {
+        std::vector<std::optional<std::string_view>> row(PQnfields(res.ptr()));
+        for (int i = 0; i < num_rows; ++i) {
+          read_row(res.ptr(), i, &row);
+          if (!_f(internal::from_row_view<T>(row))) {
+            return;
+          }
+        }
+      }
+    }
+  }
+
   static std::string make_cursor_name() {
     return "sqlgen_cursor_" + internal::random();
   }
 
+  /// Consumes the results of the streamed query that are left.
+  void drain_stream();
+
+  /// Fetches the next _batch_size rows, unless the iterator has its own
+  /// fetch size. A _result_format of 0 requests text, 1 requests binary.
+  /// When streaming, the format has been chosen when the query was sent.
+  Result<std::vector<PostgresV2Result>> fetch(const size_t _batch_size,
+                                              const int _result_format);
+
+  /// Fetches the next batch from the cursor. If prefetching is enabled, the
+  /// rows have usually been requested by the previous call already.
+  Result<PostgresV2Result> fetch_from_cursor(const size_t _batch_size,
+                                             const int _result_format);
+
+  /// Collects the results streamed by the server until there are at least
+  /// _batch_size rows or the query is done.
+  Result<std::vector<PostgresV2Result>> fetch_from_stream(
+      const size_t _batch_size);
+
+  /// The FETCH statement for the next _batch_size rows.
+  std::string make_fetch_sql(const size_t _batch_size) const {
+    return "FETCH FORWARD " + std::to_string(_batch_size) + " FROM " +
+           cursor_name_ + ";";
+  }
+
+  /// Waits for the result of the FETCH sent by the previous call to
+  /// fetch(...).
+  Result<PostgresV2Result> receive_prefetched();
+
+  /// Waits for the next result of the streamed query that contains rows.
+  /// Returns nothing once the query is done.
+  Result<std::optional<PostgresV2Result>> receive_streamed();
+
   /// Shuts the iterator down.
   void shutdown();
 
+  /// Sends _sql without a cursor and switches to chunked or single row
+  /// mode, so the rows can be read as they arrive.
+  void start_stream(const std::string& _sql,
+                    const std::vector<std::optional<std::string>>& _params);
+
  private:
   /// A unique name to identify the cursor.
   std::string cursor_name_;
@@ -69,6 +223,35 @@ class SQLGEN_API Iterator {
 
   /// Whether the end is reached.
   bool end_;
+
+  /// Whether the rows are transferred in binary format.
+  bool binary_results_;
+
+  /// The number of rows fetched at once, 0 meaning that the batch size
+  /// requested by the caller is used.
+  size_t fetch_size_;
+
+  /// Whether the next batch is requested while the current one is being
+  /// processed.
+  bool prefetch_;
+
+  /// Whether a FETCH has been sent, but its result has not been received yet.
+  bool prefetched_;
+
+  /// Whether the rows are fetched through a cursor or streamed.
+  bool use_cursor_;
+
+  /// Whether the read runs outside of a transaction begun by the user. For
+  /// cursors, this means that the iterator has begun the transaction the
+  /// cursor lives in. A stream may only be cancelled, if this is set.
+  bool own_transaction_;
+
+  /// Whether all results of the streamed query have been received.
+  bool stream_done_;
+
+  /// Rows of the streamed query that have been received, but not returned
+  /// yet.
+  std::optional<PostgresV2Result> pending_;
 };
 
 }  // namespace sqlgen::postgres
@@ -0,0 +1,93 @@
+#ifndef SQLGEN_POSTGRES_NOTIFICATIONLISTENER_HPP_
+#define SQLGEN_POSTGRES_NOTIFICATIONLISTENER_HPP_
+
+#ifdef __linux__
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../Ref.hpp"
+#include "../Result.hpp"
+#include "../sqlgen_api.hpp"
+#include "Connection.hpp"
+#include "Credentials.hpp"
+#include "PostgresV2Connection.hpp"
+
+namespace sqlgen::postgres {
+
+/// A dedicated connection that receives the notifications sent through
+/// NOTIFY and passes them on to the callbacks registered for their channel.
+/// wait(...) sleeps on the socket of the connection using epoll until
+/// notifications arrive or the timeout expires, so there is no need to poll.
+///
+/// The listener is meant to be driven by a single thread, typically one that
+/// does nothing but call wait(...) in a loop. The callbacks are run on that
+/// thread. Only wake_up() can be called from other threads.
+class SQLGEN_API NotificationListener {
+  using Conn = PostgresV2Connection;
+
+ public:
+  using Callback = std::function<void(const Notification&)>;
+
+  explicit NotificationListener(const Conn& _conn);
+
+  NotificationListener(const NotificationListener& _other) = delete;
+
+  ~NotificationListener();
+
+  static Result<Ref<NotificationListener>> make(
+      const Credentials& _credentials) noexcept;
+
+  /// Subscribes to _channel, unless there already is a callback for it, and
+  /// adds _callback to the callbacks of the channel. Must not be called from
+  /// within a callback.
+  Result<Nothing> listen(const std::string& _channel,
+                         const Callback& _callback) noexcept;
+
+  NotificationListener& operator=(const NotificationListener& _other) = delete;
+
+  /// Unsubscribes from _channel and removes its callbacks. Must not be called
+  /// from within a callback.
+  Result<Nothing> unlisten(const std::string& _channel) noexcept;
+
+  /// Waits up to _timeout for notifications and dispatches all of the ones
+  /// that have arrived. Returns Ready, if there were any or the listener was
+  /// woken up, Timeout, if nothing happened, and Error, if the connection is
+  /// broken. In the latter case, a new listener needs to be made.
+  NotificationWaitResult wait(const std::chrono::milliseconds _timeout);
+
+  /// Makes a call to wait(...) that is in progress, or the next one, return
+  /// right away. Can be called from any thread.
+  void wake_up() noexcept;
+
+ private:
+  /// Passes the notifications libpq has received to the callbacks of their
+  /// channel. Returns the number of notifications.
+  size_t dispatch();
+
+ private:
+  /// The underlying connection.
+  Conn conn_;
+
+  /// The socket of the connection.
+  int socket_;
+
+  /// The epoll instance watching the socket of the connection and wake_fd_.
+  int epoll_fd_;
+
+  /// An eventfd used to interrupt wait(...).
+  int wake_fd_;
+
+  /// The callbacks, by channel. Postgres folds the names of the channels to
+  /// lower case, so we do the same.
+  std::unordered_map<std::string, std::vector<Callback>> callbacks_;
+};
+
+}  // namespace sqlgen::postgres
+
+#endif
+
+#endif
@@ -25,9 +25,13 @@ class SQLGEN_API PostgresV2Result {
   static rfl::Result<PostgresV2Result> make(
       const std::string& _query, const PostgresV2Connection& _conn) noexcept;
 
+  /// Executes _query with _params transferred in text format. A
+  /// _result_format of 0 requests the result in text format, 1 in binary
+  /// format.
   static rfl::Result<PostgresV2Result> make(
       const std::string& _query, const PostgresV2Connection& _conn,
-      const std::vector<std::optional<std::string>>& _params) noexcept;
+      const std::vector<std::optional<std::string>>& _params,
+      const int _result_format = 0) noexcept;
 
   static rfl::Result<PostgresV2Result> make(PGresult* _ptr) noexcept {
     try {
@@ -0,0 +1,112 @@
+#ifndef SQLGEN_POSTGRES_PREPAREDSTATEMENTS_HPP_
+#define SQLGEN_POSTGRES_PREPAREDSTATEMENTS_HPP_
+
+#include <list>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "../CacheStats.hpp"
+
+namespace sqlgen::postgres {
+
+/// Keeps track of the statements that have been prepared on a single
+/// connection, so that statements that are executed repeatedly only need to
+/// be parsed and planned by the server once. Maps the SQL to the name of the
+/// prepared statement. When the cache is full, the least recently used
+/// statement is evicted and must be deallocated by the caller.
+///
+/// Like the connection it belongs to, this is not thread-safe.
+class PreparedStatements {
+ public:
+  PreparedStatements(const size_t _max_size)
+      : max_size_(_max_size), next_id_(0) {}
+
+  ~PreparedStatements() = default;
+
+  /// Whether statements should be cached at all.
+  bool enabled() const noexcept { return max_size_ != 0; }
+
+  /// Returns the name of the statement prepared for _sql, if there is one,
+  /// and marks it as the most recently used.
+  std::optional<std::string> find(const std::string& _sql) {
+    const auto it = map_.find(_sql);
+    if (it == map_.end()) {
+      ++stats_.misses;
+      return std::nullopt;
+    }
+    ++stats_.hits;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->name;
+  }
+
+  /// Forgets about the statement prepared for _sql, for instance because it
+  /// no longer exists on the server.
+  void invalidate(const std::string& _sql) {
+    const auto it = map_.find(_sql);
+    if (it == map_.end()) {
+      return;
+    }
+    entries_.erase(it->second);
+    map_.erase(it);
+    ++stats_.invalidations;
+  }
+
+  /// Generates a name for a new statement. Names are never reused on the
+  /// same connection.
+  std::string make_name() {
+    return "sqlgen_stmt_" + std::to_string(next_id_++);
+  }
+
+  /// Registers the statement _name, which has been prepared for _sql. Returns
+  /// the name of the least recently used statement, if it had to be evicted
+  /// to make room.
+  std::optional<std::string> insert(const std::string& _sql,
+                                    const std::string& _name) {
+    entries_.emplace_front(Entry{.sql = _sql, .name = _name});
+    map_[_sql] = entries_.begin();
+    if (map_.size() <= max_size_) {
+      return std::nullopt;
+    }
+    auto evicted = std::move(entries_.back().name);
+    map_.erase(entries_.back().sql);
+    entries_.pop_back();
+    ++stats_.evictions;
+    return evicted;
+  }
+
+  /// A snapshot of the hit, miss, eviction and invalidation counters.
+  CacheStats stats() const {
+    auto stats = stats_;
+    stats.size = map_.size();
+    return stats;
+  }
+
+ private:
+  struct Entry {
+    std::string sql;
+    std::string name;
+  };
+
+  using Entries = std::list<Entry>;
+
+  /// The maximum number of prepared statements, 0 meaning none are kept.
+  size_t max_size_;
+
+  /// Used to generate the names of the statements.
+  size_t next_id_;
+
+  /// The statements, with the most recently used in front.
+  Entries entries_;
+
+  /// Maps the SQL to the position of its statement in entries_.
+  std::unordered_map<std::string, Entries::iterator> map_;
+
+  /// The statistics, except for the size.
+  CacheStats stats_;
+};
+
+}  // namespace sqlgen::postgres
+
+#endif
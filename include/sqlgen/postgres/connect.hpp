@@ -3,6 +3,7 @@
 
 #include <string>
 
+#include "AsyncConnection.hpp"
 #include "Connection.hpp"
 #include "Credentials.hpp"
 
@@ -12,6 +13,17 @@ inline auto connect(const Credentials& _credentials) {
   return Connection::make(_credentials);
 }
 
+#ifdef __linux__
+
+/// Connects asynchronously, see AsyncConnection. The socket of the connection
+/// is watched by _loop.
+inline auto connect_async(const Credentials& _credentials,
+                          const Ref<EventLoop>& _loop) {
+  return AsyncConnection::make(_credentials, _loop);
+}
+
+#endif
+
 }  // namespace sqlgen::postgres
 
 #endif
@@ -0,0 +1,69 @@
+#ifndef SQLGEN_POSTGRES_FROMBINARY_HPP_
+#define SQLGEN_POSTGRES_FROMBINARY_HPP_
+
+#include <libpq-fe.h>
+
+#include <rfl.hpp>
+#include <rfl/NamedTuple.hpp>
+#include <rfl/from_named_tuple.hpp>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "../Result.hpp"
+#include "parsing/Parser.hpp"
+
+namespace sqlgen::postgres {
+
+template <class T, class NamedTupleT>
+struct FromBinary;
+
+/// Decodes a row of a result transferred in binary format straight into the
+/// fields of T, without the detour via strings.
+template <class T, class... FieldTs>
+struct FromBinary<T, rfl::NamedTuple<FieldTs...>> {
+  Result<T> operator()(const PGresult* _res, const int _row) const noexcept {
+    constexpr int num_fields = static_cast<int>(sizeof...(FieldTs));
+    if (PQnfields(_res) != num_fields) {
+      return error("Expected exactly " + std::to_string(num_fields) +
+                   " fields, but got " + std::to_string(PQnfields(_res)) +
+                   ".");
+    }
+    return [&]<int... _is>(std::integer_sequence<int, _is...>) -> Result<T> {
+      try {
+        return rfl::from_named_tuple<T>(rfl::named_tuple_t<T>(
+            read_field<typename FieldTs::Type>(_res, _row, _is,
+                                               FieldTs::name())...));
+      } catch (const std::exception& e) {
+        return error(e.what());
+      }
+    }(std::make_integer_sequence<int, num_fields>());
+  }
+
+ private:
+  template <class FieldType>
+  static FieldType read_field(const PGresult* _res, const int _row,
+                              const int _col, const std::string_view _name) {
+    const auto value =
+        parsing::BinaryValue{.oid = PQftype(_res, _col),
+                             .data = PQgetvalue(_res, _row, _col),
+                             .len = PQgetlength(_res, _row, _col)};
+    auto field = parsing::Parser<std::remove_cvref_t<FieldType>>::read(
+        PQgetisnull(_res, _row, _col) ? nullptr : &value);
+    if (!field) {
+      throw std::runtime_error("Failed to parse field '" + std::string(_name) +
+                               "': " + field.error().what());
+    }
+    return std::move(*field);
+  }
+};
+
+template <class T>
+inline const auto from_binary =
+    FromBinary<std::remove_cvref_t<T>, rfl::named_tuple_t<T>>{};
+
+}  // namespace sqlgen::postgres
+
+#endif
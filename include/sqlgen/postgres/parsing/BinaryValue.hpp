@@ -0,0 +1,101 @@
+#ifndef SQLGEN_POSTGRES_PARSING_BINARYVALUE_HPP_
+#define SQLGEN_POSTGRES_PARSING_BINARYVALUE_HPP_
+
+#include <libpq-fe.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace sqlgen::postgres::parsing {
+
+/// The OIDs of the built-in types we can decode from the binary format. They
+/// are fixed in the postgres catalog, see pg_type.dat.
+namespace oids {
+
+inline constexpr Oid boolean = 16;
+inline constexpr Oid bytea = 17;
+inline constexpr Oid character = 18;
+inline constexpr Oid name = 19;
+inline constexpr Oid int8 = 20;
+inline constexpr Oid int2 = 21;
+inline constexpr Oid int4 = 23;
+inline constexpr Oid text = 25;
+inline constexpr Oid oid = 26;
+inline constexpr Oid json = 114;
+inline constexpr Oid float4 = 700;
+inline constexpr Oid float8 = 701;
+inline constexpr Oid unknown = 705;
+inline constexpr Oid bpchar = 1042;
+inline constexpr Oid varchar = 1043;
+inline constexpr Oid date = 1082;
+inline constexpr Oid timestamp = 1114;
+inline constexpr Oid timestamptz = 1184;
+inline constexpr Oid numeric = 1700;
+inline constexpr Oid uuid = 2950;
+inline constexpr Oid jsonb = 3802;
+
+}  // namespace oids
+
+/// A single non-NULL field of a result transferred in binary format. Points
+/// into the buffer owned by the PGresult.
+struct BinaryValue {
+  /// The OID of the type of the column.
+  Oid oid;
+
+  /// The raw bytes, in network byte order.
+  const char* data;
+
+  /// The number of bytes.
+  int len;
+
+  /// Interprets the first sizeof(T) bytes as a big-endian integer or IEEE
+  /// floating point number.
+  template <class T>
+  T read_as(const size_t _offset = 0) const noexcept {
+    using UInt = std::conditional_t<
+        sizeof(T) == 8, uint64_t,
+        std::conditional_t<sizeof(T) == 4, uint32_t, uint16_t>>;
+    UInt u = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+      u = static_cast<UInt>(
+          (u << 8) | static_cast<unsigned char>(data[_offset + i]));
+    }
+    T t;
+    std::memcpy(&t, &u, sizeof(T));
+    return t;
+  }
+
+  /// Whether the column holds text that can be used as it is.
+  bool is_text() const noexcept {
+    switch (oid) {
+      case oids::bytea:
+      case oids::boolean:
+      case oids::int2:
+      case oids::int4:
+      case oids::int8:
+      case oids::oid:
+      case oids::float4:
+      case oids::float8:
+      case oids::numeric:
+      case oids::date:
+      case oids::timestamp:
+      case oids::timestamptz:
+      case oids::uuid:
+      case oids::jsonb:
+        return false;
+
+      default:
+        // This includes text, varchar, json and user-defined enums, the binary
+        // representation of which is the label.
+        return true;
+    }
+  }
+
+  std::string type_name() const { return "OID " + std::to_string(oid); }
+};
+
+}  // namespace sqlgen::postgres::parsing
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef SQLGEN_POSTGRES_PARSING_PARSER_HPP_
+#define SQLGEN_POSTGRES_PARSING_PARSER_HPP_
+
+#include "BinaryValue.hpp"
+#include "Parser_base.hpp"
+#include "Parser_default.hpp"
+#include "Parser_json.hpp"
+#include "Parser_optional.hpp"
+#include "Parser_reflection_type.hpp"
+#include "Parser_smart_ptr.hpp"
+#include "Parser_string.hpp"
+#include "Parser_timestamp.hpp"
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef SQLGEN_POSTGRES_PARSING_PARSER_BASE_HPP_
+#define SQLGEN_POSTGRES_PARSING_PARSER_BASE_HPP_
+
+namespace sqlgen::postgres::parsing {
+
+template <class T>
+struct Parser;
+
+}
+
+#endif
@@ -0,0 +1,246 @@
+#ifndef SQLGEN_POSTGRES_PARSING_PARSER_DEFAULT_HPP_
+#define SQLGEN_POSTGRES_PARSING_PARSER_DEFAULT_HPP_
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <rfl.hpp>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "../../Result.hpp"
+#include "../../parsing/Parser.hpp"
+#include "BinaryValue.hpp"
+#include "Parser_base.hpp"
+#include "append_binary.hpp"
+
+namespace sqlgen::postgres::parsing {
+
+template <class T>
+struct Parser {
+  using Type = std::remove_cvref_t<T>;
+
+  static Result<T> read(const BinaryValue* _v) noexcept {
+    if (!_v) {
+      return error("NULL value encounted: Numeric value cannot be NULL.");
+    }
+
+    if constexpr (std::is_arithmetic_v<Type>) {
+      switch (_v->oid) {
+        case oids::boolean:
+          return static_cast<Type>(_v->data[0] != 0);
+
+        case oids::int2:
+          return static_cast<Type>(_v->read_as<int16_t>());
+
+        case oids::int4:
+          return static_cast<Type>(_v->read_as<int32_t>());
+
+        case oids::int8:
+          return static_cast<Type>(_v->read_as<int64_t>());
+
+        case oids::oid:
+          return static_cast<Type>(_v->read_as<uint32_t>());
+
+        case oids::float4:
+          return static_cast<Type>(_v->read_as<float>());
+
+        case oids::float8:
+          return static_cast<Type>(_v->read_as<double>());
+
+        case oids::numeric:
+          return read_numeric(*_v);
+
+        default:
+          break;
+      }
+    }
+
+    // Everything else, like enums, is transferred as text, even in the binary
+    // format.
+    if (!_v->is_text()) {
+      return error("Cannot decode a value of type " + _v->type_name() +
+                   " transferred in binary format.");
+    }
+    return sqlgen::parsing::read_value<Type>(
+        std::string_view(_v->data, _v->len));
+  }
+
+  static Result<Nothing> write(const T& _t, std::string* _buffer) noexcept {
+    if constexpr (std::is_same_v<Type, bool>) {
+      append_as<int32_t>(1, _buffer);
+      _buffer->push_back(_t ? 1 : 0);
+      return Nothing{};
+
+    } else if constexpr (std::is_integral_v<Type>) {
+      // The type of the column depends on the size of the integer, see
+      // type_to_sql(...).
+      using IntType = std::conditional_t<
+          sizeof(Type) <= 2, int16_t,
+          std::conditional_t<sizeof(Type) == 4, int32_t, int64_t>>;
+      if (!std::in_range<IntType>(_t)) {
+        return error("Value " + std::to_string(_t) +
+                     " is out of range for a column with " +
+                     std::to_string(8 * sizeof(IntType)) + " bits.");
+      }
+      append_number_field(static_cast<IntType>(_t), _buffer);
+      return Nothing{};
+
+    } else if constexpr (std::is_floating_point_v<Type>) {
+      // Floating point numbers are stored as NUMERIC, see type_to_sql(...).
+      return write_numeric(static_cast<double>(_t), _buffer);
+
+    } else if constexpr (std::is_enum_v<Type>) {
+      // Enums are transferred as their label, even in the binary format.
+      return append_field(rfl::enum_to_string(_t), _buffer);
+
+    } else {
+      return error(
+          "There is no binary format for this type. Either specialize "
+          "sqlgen::postgres::parsing::Parser<T> or write in text format.");
+    }
+  }
+
+ private:
+  /// NUMERIC values are transferred as a sequence of base 10000 digits,
+  /// preceded by the number of digits, the weight of the first digit, the
+  /// sign and the display scale.
+  static Result<T> read_numeric(const BinaryValue& _v) noexcept {
+    const auto ndigits = _v.read_as<int16_t>(0);
+    const auto weight = _v.read_as<int16_t>(2);
+    const auto sign = _v.read_as<uint16_t>(4);
+
+    constexpr uint16_t negative = 0x4000;
+    constexpr uint16_t nan = 0xC000;
+
+    const auto digit = [&](const int _i) -> int64_t {
+      return _i < ndigits ? _v.read_as<int16_t>(8 + 2 * _i) : 0;
+    };
+
+    if constexpr (std::is_floating_point_v<Type>) {
+      if (sign != 0 && sign != negative) {
+        return std::numeric_limits<Type>::quiet_NaN();
+      }
+      double val = 0.0;
+      for (int i = 0; i < ndigits; ++i) {
+        val = val * 10000.0 + static_cast<double>(digit(i));
+      }
+      val *= std::pow(10000.0, weight - ndigits + 1);
+      return static_cast<Type>(sign == negative ? -val : val);
+
+    } else {
+      if (sign != 0 && sign != negative) {
+        return error(sign == nan ? "Cannot convert NaN to an integer."
+                                 : "Cannot convert infinity to an integer.");
+      }
+      // Digits after the decimal point are truncated.
+      int64_t val = 0;
+      for (int i = 0; i <= weight; ++i) {
+        val = val * 10000 + digit(i);
+      }
+      return static_cast<Type>(sign == negative ? -val : val);
+    }
+  }
+
+  /// Writes the shortest decimal representation of _d that reads back as _d
+  /// in the NUMERIC format, see read_numeric(...).
+  static Result<Nothing> write_numeric(const double _d,
+                                       std::string* _buffer) noexcept {
+    constexpr uint16_t negative = 0x4000;
+    constexpr uint16_t nan = 0xC000;
+    constexpr uint16_t pinf = 0xD000;
+    constexpr uint16_t ninf = 0xF000;
+
+    const auto write_header = [&](const int16_t _ndigits,
+                                  const int16_t _weight, const uint16_t _sign,
+                                  const int16_t _dscale) {
+      append_as<int32_t>(8 + 2 * _ndigits, _buffer);
+      append_as<int16_t>(_ndigits, _buffer);
+      append_as<int16_t>(_weight, _buffer);
+      append_as<uint16_t>(_sign, _buffer);
+      append_as<int16_t>(_dscale, _buffer);
+    };
+
+    if (std::isnan(_d)) {
+      write_header(0, 0, nan, 0);
+      return Nothing{};
+    }
+
+    if (std::isinf(_d)) {
+      write_header(0, 0, _d < 0.0 ? ninf : pinf, 0);
+      return Nothing{};
+    }
+
+    // The longest fixed representation of a double is that of the smallest
+    // denormal number, which has about 330 characters.
+    char str[512];
+    const auto res = std::to_chars(str, str + sizeof(str), std::abs(_d),
+                                   std::chars_format::fixed);
+    if (res.ec != std::errc()) {
+      return error("Could not convert " + std::to_string(_d) + " to NUMERIC.");
+    }
+
+    const auto fixed = std::string_view(str, res.ptr - str);
+    const auto point = fixed.find('.');
+    const auto int_part = fixed.substr(0, point);
+    const auto frac_part = point == std::string_view::npos
+                               ? std::string_view()
+                               : fixed.substr(point + 1);
+
+    // Pad the decimal digits with zeros, so that they can be split into
+    // groups of four on both sides of the decimal point.
+    char padded[520];
+    size_t len = 0;
+    const auto int_pad = (4 - int_part.size() % 4) % 4;
+    const auto frac_pad = (4 - frac_part.size() % 4) % 4;
+    for (size_t i = 0; i < int_pad; ++i) {
+      padded[len++] = '0';
+    }
+    for (const char c : int_part) {
+      padded[len++] = c;
+    }
+    for (const char c : frac_part) {
+      padded[len++] = c;
+    }
+    for (size_t i = 0; i < frac_pad; ++i) {
+      padded[len++] = '0';
+    }
+
+    int16_t digits[130];
+    const size_t num_groups = len / 4;
+    for (size_t i = 0; i < num_groups; ++i) {
+      digits[i] = static_cast<int16_t>(
+          (padded[4 * i] - '0') * 1000 + (padded[4 * i + 1] - '0') * 100 +
+          (padded[4 * i + 2] - '0') * 10 + (padded[4 * i + 3] - '0'));
+    }
+
+    // Leading and trailing zeros are not stored.
+    auto weight = static_cast<int16_t>((int_part.size() + int_pad) / 4 - 1);
+    size_t begin = 0;
+    while (begin < num_groups && digits[begin] == 0) {
+      ++begin;
+      --weight;
+    }
+    size_t end = num_groups;
+    while (end > begin && digits[end - 1] == 0) {
+      --end;
+    }
+
+    const auto ndigits = static_cast<int16_t>(end - begin);
+    write_header(ndigits, ndigits == 0 ? 0 : weight,
+                 _d < 0.0 ? negative : 0,
+                 static_cast<int16_t>(frac_part.size()));
+    for (size_t i = begin; i < end; ++i) {
+      append_as<int16_t>(digits[i], _buffer);
+    }
+    return Nothing{};
+  }
+};
+
+}  // namespace sqlgen::postgres::parsing
+
+#endif
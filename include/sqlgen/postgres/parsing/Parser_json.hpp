@@ -0,0 +1,35 @@
+#ifndef SQLGEN_POSTGRES_PARSING_PARSER_JSON_HPP_
+#define SQLGEN_POSTGRES_PARSING_PARSER_JSON_HPP_
+
+#include <rfl/json.hpp>
+#include <string>
+
+#include "../../JSON.hpp"
+#include "../../Result.hpp"
+#include "../../parsing/Parser.hpp"
+#include "BinaryValue.hpp"
+#include "Parser_base.hpp"
+#include "Parser_string.hpp"
+#include "append_binary.hpp"
+
+namespace sqlgen::postgres::parsing {
+
+template <class T>
+struct Parser<JSON<T>> {
+  static Result<JSON<T>> read(const BinaryValue* _v) noexcept {
+    return Parser<std::string>::read(_v).and_then([](auto&& _str) {
+      return sqlgen::parsing::Parser<JSON<T>>::read(std::move(_str));
+    });
+  }
+
+  /// JSON values are stored as JSONB, see type_to_sql(...), which is
+  /// transferred as a version byte followed by the text.
+  static Result<Nothing> write(const JSON<T>& _j,
+                               std::string* _buffer) noexcept {
+    return append_field("\x01" + rfl::json::write(_j.value()), _buffer);
+  }
+};
+
+}  // namespace sqlgen::postgres::parsing
+
+#endif
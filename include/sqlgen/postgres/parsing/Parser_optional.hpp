@@ -0,0 +1,39 @@
+#ifndef SQLGEN_POSTGRES_PARSING_PARSER_OPTIONAL_HPP_
+#define SQLGEN_POSTGRES_PARSING_PARSER_OPTIONAL_HPP_
+
+#include <optional>
+#include <string>
+#include <type_traits>
+
+#include "../../Result.hpp"
+#include "BinaryValue.hpp"
+#include "Parser_base.hpp"
+#include "append_binary.hpp"
+
+namespace sqlgen::postgres::parsing {
+
+template <class T>
+struct Parser<std::optional<T>> {
+  static Result<std::optional<T>> read(const BinaryValue* _v) noexcept {
+    if (!_v) {
+      return std::optional<T>();
+    }
+    return Parser<std::remove_cvref_t<T>>::read(_v).transform(
+        [](auto&& _t) -> std::optional<T> {
+          return std::make_optional<T>(std::move(_t));
+        });
+  }
+
+  static Result<Nothing> write(const std::optional<T>& _o,
+                               std::string* _buffer) noexcept {
+    if (!_o) {
+      append_null(_buffer);
+      return Nothing{};
+    }
+    return Parser<std::remove_cvref_t<T>>::write(*_o, _buffer);
+  }
+};
+
+}  // namespace sqlgen::postgres::parsing
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef SQLGEN_POSTGRES_PARSING_PARSER_REFLECTION_TYPE_HPP_
+#define SQLGEN_POSTGRES_PARSING_PARSER_REFLECTION_TYPE_HPP_
+
+#include <string>
+#include <type_traits>
+
+#include "../../Result.hpp"
+#include "../../transpilation/has_reflection_method.hpp"
+#include "BinaryValue.hpp"
+#include "Parser_base.hpp"
+
+namespace sqlgen::postgres::parsing {
+
+template <class T>
+  requires transpilation::has_reflection_method<std::remove_cvref_t<T>>
+struct Parser<T> {
+  using Type = std::remove_cvref_t<T>;
+
+  static Result<T> read(const BinaryValue* _v) noexcept {
+    return Parser<std::remove_cvref_t<typename Type::ReflectionType>>::read(_v)
+        .transform([](auto&& _t) { return T(std::move(_t)); });
+  }
+
+  static Result<Nothing> write(const T& _t, std::string* _buffer) noexcept {
+    return Parser<std::remove_cvref_t<typename Type::ReflectionType>>::write(
+        _t.reflection(), _buffer);
+  }
+};
+
+}  // namespace sqlgen::postgres::parsing
+
+#endif
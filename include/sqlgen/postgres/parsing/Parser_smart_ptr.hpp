@@ -0,0 +1,42 @@
+#ifndef SQLGEN_POSTGRES_PARSING_PARSER_SMART_PTR_HPP_
+#define SQLGEN_POSTGRES_PARSING_PARSER_SMART_PTR_HPP_
+
+#include <string>
+#include <type_traits>
+
+#include "../../Result.hpp"
+#include "../../transpilation/is_nullable.hpp"
+#include "BinaryValue.hpp"
+#include "Parser_base.hpp"
+#include "append_binary.hpp"
+
+namespace sqlgen::postgres::parsing {
+
+template <class T>
+  requires transpilation::is_ptr<std::remove_cvref_t<T>>::value
+struct Parser<T> {
+  using Type = std::remove_cvref_t<T>;
+
+  static Result<T> read(const BinaryValue* _v) noexcept {
+    if (!_v) {
+      return T();
+    }
+    return Parser<typename Type::element_type>::read(_v).transform(
+        [](auto&& _u) -> T {
+          using U = std::remove_cvref_t<decltype(_u)>;
+          return T(new U(std::move(_u)));
+        });
+  }
+
+  static Result<Nothing> write(const T& _ptr, std::string* _buffer) noexcept {
+    if (!_ptr) {
+      append_null(_buffer);
+      return Nothing{};
+    }
+    return Parser<typename Type::element_type>::write(*_ptr, _buffer);
+  }
+};
+
+}  // namespace sqlgen::postgres::parsing
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef SQLGEN_POSTGRES_PARSING_PARSER_STRING_HPP_
+#define SQLGEN_POSTGRES_PARSING_PARSER_STRING_HPP_
+
+#include <cstdint>
+#include <string>
+
+#include "../../Result.hpp"
+#include "BinaryValue.hpp"
+#include "Parser_base.hpp"
+#include "append_binary.hpp"
+
+namespace sqlgen::postgres::parsing {
+
+template <>
+struct Parser<std::string> {
+  static Result<std::string> read(const BinaryValue* _v) noexcept {
+    if (!_v) {
+      return error("NULL value encounted: String value cannot be NULL.");
+    }
+
+    switch (_v->oid) {
+      case oids::boolean:
+        return std::string(_v->data[0] ? "t" : "f");
+
+      case oids::bytea:
+        return std::string(_v->data, _v->len);
+
+      case oids::int2:
+        return std::to_string(_v->read_as<int16_t>());
+
+      case oids::int4:
+        return std::to_string(_v->read_as<int32_t>());
+
+      case oids::int8:
+        return std::to_string(_v->read_as<int64_t>());
+
+      case oids::jsonb:
+        // The first byte is the version of the format, followed by the text.
+        return _v->len > 0 ? std::string(_v->data + 1, _v->len - 1)
+                           : std::string();
+
+      case oids::uuid:
+        return uuid_to_string(*_v);
+
+      default:
+        if (!_v->is_text()) {
+          return error("Cannot decode a value of type " + _v->type_name() +
+                       " transferred in binary format as a string.");
+        }
+        return std::string(_v->data, _v->len);
+    }
+  }
+
+  static Result<Nothing> write(const std::string& _str,
+                               std::string* _buffer) noexcept {
+    return append_field(_str, _buffer);
+  }
+
+ private:
+  static std::string uuid_to_string(const BinaryValue& _v) {
+    constexpr char hex[] = "0123456789abcdef";
+    std::string str;
+    str.reserve(36);
+    for (int i = 0; i < _v.len; ++i) {
+      if (i == 4 || i == 6 || i == 8 || i == 10) {
+        str += '-';
+      }
+      const auto byte = static_cast<unsigned char>(_v.data[i]);
+      str += hex[byte >> 4];
+      str += hex[byte & 0x0F];
+    }
+    return str;
+  }
+};
+
+}  // namespace sqlgen::postgres::parsing
+
+#endif
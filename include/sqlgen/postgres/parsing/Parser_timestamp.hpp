@@ -0,0 +1,98 @@
+#ifndef SQLGEN_POSTGRES_PARSING_PARSER_TIMESTAMP_HPP_
+#define SQLGEN_POSTGRES_PARSING_PARSER_TIMESTAMP_HPP_
+
+#include <cstdint>
+#include <ctime>
+#include <limits>
+#include <rfl.hpp>
+#include <rfl/internal/StringLiteral.hpp>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "../../Result.hpp"
+#include "../../dynamic/types.hpp"
+#include "../../parsing/Parser.hpp"
+#include "BinaryValue.hpp"
+#include "Parser_base.hpp"
+#include "append_binary.hpp"
+
+namespace sqlgen::postgres::parsing {
+
+template <rfl::internal::StringLiteral _format>
+struct Parser<rfl::Timestamp<_format>> {
+  using TSType = rfl::Timestamp<_format>;
+
+  /// Postgres counts from 2000-01-01 instead of 1970-01-01.
+  static constexpr time_t postgres_epoch = 946684800;
+
+  static constexpr time_t seconds_per_day = 24 * 60 * 60;
+
+  static Result<TSType> read(const BinaryValue* _v) noexcept {
+    if (!_v) {
+      return error("Timestamp value cannot be NULL.");
+    }
+
+    switch (_v->oid) {
+      case oids::timestamp:
+      case oids::timestamptz: {
+        const auto micros = _v->read_as<int64_t>();
+        if (micros == std::numeric_limits<int64_t>::max() ||
+            micros == std::numeric_limits<int64_t>::min()) {
+          return error("Infinite timestamps are not supported.");
+        }
+        // Round towards negative infinity, so that timestamps before 2000
+        // are not off by one second.
+        const auto seconds =
+            micros / 1000000 - (micros % 1000000 < 0 ? 1 : 0);
+        return TSType(static_cast<time_t>(seconds) + postgres_epoch);
+      }
+
+      case oids::date: {
+        const auto days = _v->read_as<int32_t>();
+        if (days == std::numeric_limits<int32_t>::max() ||
+            days == std::numeric_limits<int32_t>::min()) {
+          return error("Infinite dates are not supported.");
+        }
+        return TSType(static_cast<time_t>(days) * seconds_per_day +
+                      postgres_epoch);
+      }
+
+      default:
+        if (!_v->is_text()) {
+          return error("Cannot decode a value of type " + _v->type_name() +
+                       " transferred in binary format as a timestamp.");
+        }
+        return sqlgen::parsing::Parser<TSType>::read(
+            std::string_view(_v->data, _v->len));
+    }
+  }
+
+  static Result<Nothing> write(const TSType& _t,
+                               std::string* _buffer) noexcept {
+    const auto seconds = static_cast<int64_t>(_t.to_time_t() - postgres_epoch);
+    if (is_date()) {
+      // Round towards negative infinity, like in read(...).
+      const auto days =
+          seconds / seconds_per_day - (seconds % seconds_per_day < 0 ? 1 : 0);
+      append_number_field(static_cast<int32_t>(days), _buffer);
+    } else {
+      append_number_field(seconds * 1000000, _buffer);
+    }
+    return Nothing{};
+  }
+
+ private:
+  /// Whether the column is of type DATE, which depends on the format, see
+  /// sqlgen::parsing::Parser<TSType>::to_type().
+  static bool is_date() noexcept {
+    return sqlgen::parsing::Parser<TSType>::to_type().visit([](const auto& _t) {
+      return std::is_same_v<std::remove_cvref_t<decltype(_t)>,
+                            dynamic::types::Date>;
+    });
+  }
+};
+
+}  // namespace sqlgen::postgres::parsing
+
+#endif
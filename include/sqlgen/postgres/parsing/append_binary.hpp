@@ -0,0 +1,58 @@
+#ifndef SQLGEN_POSTGRES_PARSING_APPEND_BINARY_HPP_
+#define SQLGEN_POSTGRES_PARSING_APPEND_BINARY_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "../../Result.hpp"
+
+namespace sqlgen::postgres::parsing {
+
+/// Appends _t to _buffer as a big-endian integer or IEEE floating point
+/// number. The counterpart of BinaryValue::read_as.
+template <class T>
+void append_as(const T _t, std::string* _buffer) {
+  using UInt = std::conditional_t<
+      sizeof(T) == 8, uint64_t,
+      std::conditional_t<sizeof(T) == 4, uint32_t, uint16_t>>;
+  UInt u;
+  std::memcpy(&u, &_t, sizeof(T));
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    _buffer->push_back(
+        static_cast<char>((u >> (8 * (sizeof(T) - 1 - i))) & 0xFF));
+  }
+}
+
+/// Appends a NULL field in the binary COPY format.
+inline void append_null(std::string* _buffer) {
+  append_as<int32_t>(-1, _buffer);
+}
+
+/// Appends a field in the binary COPY format, which is the number of bytes
+/// followed by the bytes themselves.
+inline Result<Nothing> append_field(const std::string_view _bytes,
+                                    std::string* _buffer) {
+  if (_bytes.size() >
+      static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    return error("Field of " + std::to_string(_bytes.size()) +
+                 " bytes is too large for the binary COPY format.");
+  }
+  append_as<int32_t>(static_cast<int32_t>(_bytes.size()), _buffer);
+  _buffer->append(_bytes);
+  return Nothing{};
+}
+
+/// Appends a field holding a single number.
+template <class T>
+void append_number_field(const T _t, std::string* _buffer) {
+  append_as<int32_t>(static_cast<int32_t>(sizeof(T)), _buffer);
+  append_as<T>(_t, _buffer);
+}
+
+}  // namespace sqlgen::postgres::parsing
+
+#endif
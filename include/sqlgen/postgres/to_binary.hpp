@@ -0,0 +1,41 @@
+#ifndef SQLGEN_POSTGRES_TOBINARY_HPP_
+#define SQLGEN_POSTGRES_TOBINARY_HPP_
+
+#include <cstdint>
+#include <rfl.hpp>
+#include <string>
+#include <type_traits>
+
+#include "../Result.hpp"
+#include "../internal/remove_auto_incr_primary_t.hpp"
+#include "parsing/Parser.hpp"
+#include "parsing/append_binary.hpp"
+
+namespace sqlgen::postgres {
+
+/// Appends _t to _buffer as a tuple in the binary COPY format, without the
+/// detour via strings. Auto-incrementing primary keys are skipped, just like
+/// in the text format. The counterpart of from_binary.
+template <class T>
+Result<Nothing> to_binary(const T& _t, std::string* _buffer) noexcept {
+  const auto view = rfl::to_view(_t);
+  using ViewType = internal::remove_auto_incr_primary_t<decltype(view)>;
+  return rfl::apply(
+      [&](const auto... _ptrs) -> Result<Nothing> {
+        parsing::append_as<int16_t>(static_cast<int16_t>(sizeof...(_ptrs)),
+                                    _buffer);
+        Result<Nothing> res = Nothing{};
+        const auto write_field = [&](const auto* _ptr) {
+          using FieldType = std::remove_cvref_t<decltype(*_ptr)>;
+          res = parsing::Parser<FieldType>::write(*_ptr, _buffer);
+          return static_cast<bool>(res);
+        };
+        (write_field(_ptrs) && ...);
+        return res;
+      },
+      ViewType(view).values());
+}
+
+}  // namespace sqlgen::postgres
+
+#endif
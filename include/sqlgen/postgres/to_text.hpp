@@ -0,0 +1,63 @@
+#ifndef SQLGEN_POSTGRES_TOTEXT_HPP_
+#define SQLGEN_POSTGRES_TOTEXT_HPP_
+
+#include <optional>
+#include <rfl.hpp>
+#include <string>
+
+#include "../internal/remove_auto_incr_primary_t.hpp"
+#include "../internal/to_str.hpp"
+
+namespace sqlgen::postgres {
+
+/// Appends a single field in the text format of COPY, see write_to_sql(...).
+/// NULL is written as \e. Fields that contain the delimiter, a line break or
+/// the quote character \a, or that could be mistaken for NULL, are quoted,
+/// doubling any quote characters inside.
+inline void append_text_field(const std::optional<std::string>& _field,
+                              std::string* _buffer) {
+  if (!_field) {
+    _buffer->push_back('\e');
+    return;
+  }
+  if (*_field != "\e" &&
+      _field->find_first_of("\t\n\r\a") == std::string::npos) {
+    _buffer->append(*_field);
+    return;
+  }
+  _buffer->push_back('\a');
+  for (const char c : *_field) {
+    if (c == '\a') {
+      _buffer->push_back('\a');
+    }
+    _buffer->push_back(c);
+  }
+  _buffer->push_back('\a');
+}
+
+/// Appends _t to _buffer as a line in the text format of COPY. The fields
+/// are escaped in place, so no temporary vectors or strings are needed for
+/// the line as a whole. Auto-incrementing primary keys are skipped.
+template <class T>
+void to_text(const T& _t, std::string* _buffer) {
+  const auto view = rfl::to_view(_t);
+  using ViewType = internal::remove_auto_incr_primary_t<decltype(view)>;
+  rfl::apply(
+      [&](const auto... _ptrs) {
+        bool first = true;
+        const auto append = [&](const auto* _ptr) {
+          if (!first) {
+            _buffer->push_back('\t');
+          }
+          first = false;
+          append_text_field(internal::to_str(*_ptr), _buffer);
+        };
+        (append(_ptrs), ...);
+      },
+      ViewType(view).values());
+  _buffer->push_back('\n');
+}
+
+}  // namespace sqlgen::postgres
+
+#endif
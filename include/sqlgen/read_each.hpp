@@ -0,0 +1,67 @@
+#ifndef SQLGEN_READ_EACH_HPP_
+#define SQLGEN_READ_EACH_HPP_
+
+#include <type_traits>
+
+#include "Range.hpp"
+#include "Ref.hpp"
+#include "Result.hpp"
+#include "internal/for_each.hpp"
+#include "is_connection.hpp"
+#include "read.hpp"
+
+namespace sqlgen {
+
+/// Reads the rows of the table of T and passes them to a callback one at a
+/// time, instead of collecting them in a container. Where the connector
+/// supports it, every row is handed over as soon as it has been parsed, so
+/// consumers that only aggregate the rows need no memory beyond a single
+/// batch. Supports where(...), order_by(...), limit(...) and offset(...)
+/// just like read<...>.
+template <class ReadType, class F>
+struct ReadEach {
+  auto operator()(const auto& _conn) const { return with_conn(_conn); }
+
+  template <class OpType>
+    requires requires(const ReadType& _r, const OpType& _op) { _r | _op; }
+  friend auto operator|(const ReadEach& _r, const OpType& _op) {
+    using NewReadType = std::remove_cvref_t<decltype(_r.read_ | _op)>;
+    return ReadEach<NewReadType, F>{.read_ = _r.read_ | _op, .f_ = _r.f_};
+  }
+
+  ReadType read_;
+
+  F f_;
+
+ private:
+  template <class Connection>
+    requires is_connection<Connection>
+  Result<Ref<Connection>> with_conn(const Ref<Connection>& _conn) const {
+    return read_(_conn)
+        .and_then([&](const auto& _range) {
+          return internal::for_each(_range, f_);
+        })
+        .transform([&](const auto&) { return _conn; });
+  }
+
+  template <class Connection>
+    requires is_connection<Connection>
+  Result<Ref<Connection>> with_conn(const Result<Ref<Connection>>& _res) const {
+    return _res.and_then([&](const auto& _conn) { return with_conn(_conn); });
+  }
+};
+
+/// _f is called with every row as an rvalue of type T.
+template <class T, class F>
+auto read_each(const F& _f) {
+  return ReadEach<Read<Range<T>>, F>{.read_ = Read<Range<T>>{}, .f_ = _f};
+}
+
+template <class T, class Connection, class F>
+auto read_each(const Connection& _conn, const F& _f) {
+  return read_each<T>(_f)(_conn);
+}
+
+}  // namespace sqlgen
+
+#endif
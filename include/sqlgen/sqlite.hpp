@@ -2,6 +2,7 @@
 #define SQLGEN_SQLITE_HPP_
 
 #include "../sqlgen.hpp"
+#include "sqlite/ReadWritePool.hpp"
 #include "sqlite/connect.hpp"
 
 #endif
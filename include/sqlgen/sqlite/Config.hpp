@@ -0,0 +1,76 @@
+#ifndef SQLGEN_SQLITE_CONFIG_HPP_
+#define SQLGEN_SQLITE_CONFIG_HPP_
+
+#include <sqlite3.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "../Literal.hpp"
+
+namespace sqlgen::sqlite {
+
+/// Everything needed to open a connection. The settings that are not set
+/// keep the defaults of SQLite. They are applied whenever a connection is
+/// opened, so they also hold for every connection in a pool.
+struct Config {
+  using JournalMode =
+      Literal<"DELETE", "TRUNCATE", "PERSIST", "MEMORY", "WAL", "OFF">;
+  using Synchronous = Literal<"OFF", "NORMAL", "FULL", "EXTRA">;
+  using TempStore = Literal<"DEFAULT", "FILE", "MEMORY">;
+
+  /// The file containing the database, or ":memory:".
+  std::string fname = ":memory:";
+
+  /// The flags passed to sqlite3_open_v2. Connections are never shared
+  /// between threads, so SQLITE_OPEN_NOMUTEX is safe to add.
+  int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+
+  /// How long a statement waits for a lock held by another connection before
+  /// failing with SQLITE_BUSY, in milliseconds.
+  std::optional<int> busy_timeout;
+
+  /// PRAGMA journal_mode. WAL lets readers and a writer proceed at the same
+  /// time and turns most commits into a sequential append.
+  std::optional<JournalMode> journal_mode;
+
+  /// PRAGMA synchronous. In WAL mode, NORMAL is durable against application
+  /// crashes and only syncs at checkpoints.
+  std::optional<Synchronous> synchronous;
+
+  /// PRAGMA cache_size. Positive values are pages, negative values KiB.
+  std::optional<int64_t> cache_size;
+
+  /// PRAGMA mmap_size, the number of bytes of the database file that are
+  /// memory-mapped instead of read through system calls.
+  std::optional<int64_t> mmap_size;
+
+  /// PRAGMA temp_store, where temporary tables and indices are kept.
+  std::optional<TempStore> temp_store;
+
+  /// The maximum number of prepared statements kept on each connection. 0
+  /// disables the cache.
+  size_t max_prepared_statements = 64;
+
+  /// A profile for throughput: WAL with synchronous=NORMAL, 64 MiB of page
+  /// cache, 256 MiB of memory-mapped I/O, temporary tables in memory and a
+  /// busy timeout of five seconds. A crash of the machine, but not of the
+  /// application, may lose the most recent transactions.
+  static Config high_throughput(const std::string& _fname) {
+    return Config{.fname = _fname,
+                  .flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE |
+                           SQLITE_OPEN_NOMUTEX,
+                  .busy_timeout = 5000,
+                  .journal_mode = JournalMode::make<"WAL">(),
+                  .synchronous = Synchronous::make<"NORMAL">(),
+                  .cache_size = -65536,
+                  .mmap_size = 268435456,
+                  .temp_store = TempStore::make<"MEMORY">()};
+  }
+};
+
+}  // namespace sqlgen::sqlite
+
+#endif
@@ -4,11 +4,14 @@
 #include <sqlite3.h>
 
 #include <memory>
+#include <optional>
 #include <rfl.hpp>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <variant>
 
+#include "../CacheStats.hpp"
 #include "../Iterator.hpp"
 #include "../Ref.hpp"
 #include "../Result.hpp"
@@ -16,13 +19,17 @@
 #include "../Transaction.hpp"
 #include "../dynamic/SelectFrom.hpp"
 #include "../dynamic/Union.hpp"
+#include "../dynamic/Value.hpp"
 #include "../dynamic/Write.hpp"
+#include "../internal/batch_size.hpp"
 #include "../internal/to_container.hpp"
 #include "../internal/write_or_insert.hpp"
 #include "../is_connection.hpp"
 #include "../sqlgen_api.hpp"
 #include "../transpilation/value_t.hpp"
+#include "Config.hpp"
 #include "Iterator.hpp"
+#include "PreparedStatements.hpp"
 #include "to_sql.hpp"
 
 namespace sqlgen::sqlite {
@@ -32,9 +39,21 @@ class SQLGEN_API Connection {
   using StmtPtr = std::shared_ptr<sqlite3_stmt>;
 
  public:
-  Connection(const std::string& _fname);
+  /// Up to _max_prepared_statements statements are kept prepared, so that
+  /// queries that are executed repeatedly, like point lookups or inserts,
+  /// only need to be parsed and planned once. 0 disables this.
+  Connection(const std::string& _fname,
+             const size_t _max_prepared_statements = 64);
 
-  static rfl::Result<Ref<Connection>> make(const std::string& _fname) noexcept;
+  /// Opens the connection with the flags of _config and applies its
+  /// settings.
+  explicit Connection(const Config& _config);
+
+  static rfl::Result<Ref<Connection>> make(
+      const std::string& _fname,
+      const size_t _max_prepared_statements = 64) noexcept;
+
+  static rfl::Result<Ref<Connection>> make(const Config& _config) noexcept;
 
   ~Connection();
 
@@ -44,6 +63,10 @@ class SQLGEN_API Connection {
 
   Result<Nothing> execute(const std::string& _sql) noexcept;
 
+  /// Executes _stmt, with the literals in its conditions and SET clauses
+  /// bound as parameters, so they do not have to be escaped.
+  Result<Nothing> execute_statement(const dynamic::Statement& _stmt) noexcept;
+
   template <class ItBegin, class ItEnd>
   Result<Nothing> insert(const dynamic::Insert& _stmt, ItBegin _begin,
                          ItEnd _end) noexcept {
@@ -61,6 +84,13 @@ class SQLGEN_API Connection {
         }));
   }
 
+  /// A snapshot of the statistics of the prepared statements kept on this
+  /// connection. Every hit is a statement SQLite did not have to parse and
+  /// plan again.
+  CacheStats prepared_statement_stats() const noexcept {
+    return prepared_statements_.stats();
+  }
+
   Result<Nothing> rollback() noexcept;
 
   std::string to_sql(const dynamic::Statement& _stmt) noexcept;
@@ -76,13 +106,30 @@ class SQLGEN_API Connection {
   }
 
  private:
-  /// Generates the underlying connection.
-  static ConnPtr make_conn(const std::string& _fname);
+  /// Binds the values generated by to_sql_impl(_stmt, &_params) to the
+  /// placeholders of _stmt.
+  Result<Nothing> bind_params(
+      const std::vector<dynamic::Value>& _params,
+      sqlite3_stmt* _stmt) const noexcept;
 
-  /// Actually inserts data based on a prepared statement -
-  /// used by both .insert(...) and .write(...).
+  /// Generates the underlying connection and applies the settings of
+  /// _config.
+  static ConnPtr make_conn(const Config& _config);
+
+  /// Actually inserts the data, using multi-row INSERT statements that
+  /// insert as many rows at once as the limit on the number of placeholders
+  /// allows, and one more statement for the remaining rows - used by both
+  /// .insert(...) and .write(...).
   Result<Nothing> actual_insert(
+      const std::variant<dynamic::Insert, dynamic::Write>& _stmt,
+      const std::vector<std::vector<std::optional<std::string>>>&
+          _data) noexcept;
+
+  /// Binds the rows of _data starting at _begin to the placeholders of
+  /// _stmt, which inserts _num_rows rows, and executes it.
+  Result<Nothing> insert_rows(
       const std::vector<std::vector<std::optional<std::string>>>& _data,
+      const size_t _begin, const size_t _num_rows,
       sqlite3_stmt* _stmt) const noexcept;
 
   /// Implements the actual insert.
@@ -91,8 +138,14 @@ class SQLGEN_API Connection {
       const std::vector<std::vector<std::optional<std::string>>>&
           _data) noexcept;
 
-  /// Generates a prepared statment, usually for inserts.
-  Result<StmtPtr> prepare_statement(const std::string& _sql) const noexcept;
+  /// Returns the statement prepared for _sql, preparing it, if it is not in
+  /// the cache.
+  Result<StmtPtr> prepare_statement(const std::string& _sql) noexcept;
+
+  /// The number of rows a single INSERT statement with _num_cols columns can
+  /// insert without exceeding the limit on the number of placeholders, but
+  /// no more than SQLGEN_ROWS_PER_INSERT.
+  size_t max_rows_per_insert(const size_t _num_cols) const noexcept;
 
   /// Implements the actual read.
   Result<Ref<Iterator>> read_impl(
@@ -103,12 +156,14 @@ class SQLGEN_API Connection {
       const std::vector<std::vector<std::optional<std::string>>>& _data);
 
  private:
-  /// A prepared statement - needed for the read and write operations. Note that
-  /// we have declared it before conn_, meaning it will be destroyed first.
-  StmtPtr stmt_;
+  /// The write operation launched by .start_write(...), if any.
+  std::optional<dynamic::Write> write_;
 
   /// The underlying sqlite3 connection.
   ConnPtr conn_;
+
+  /// The statements prepared on this connection, keyed by their SQL.
+  PreparedStatements prepared_statements_;
 };
 
 }  // namespace sqlgen::sqlite
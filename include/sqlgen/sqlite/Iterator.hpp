@@ -5,11 +5,14 @@
 
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "../Ref.hpp"
 #include "../Result.hpp"
+#include "../internal/from_str_vec.hpp"
 #include "../sqlgen_api.hpp"
+#include "from_stmt.hpp"
 
 namespace sqlgen::sqlite {
 
@@ -31,6 +34,46 @@ class SQLGEN_API Iterator {
   Result<std::vector<std::vector<std::optional<std::string>>>> next(
       const size_t _batch_size);
 
+  /// Returns the next batch of rows, parsed into T. The values are read
+  /// straight from the prepared statement, numbers as numbers and text as
+  /// views into the buffers of the statement.
+  template <class T>
+  Result<std::vector<Result<T>>> next_as(const size_t _batch_size) {
+    if (end()) {
+      return error("End is reached.");
+    }
+
+    std::vector<Result<T>> batch;
+
+    for (size_t i = 0; i < _batch_size && !end(); ++i) {
+      batch.emplace_back(from_stmt<T>(stmt_.get()));
+      step();
+    }
+
+    return batch;
+  }
+
+  /// Parses the next batch of rows into T and passes them to _f one at a
+  /// time, without collecting them. Stops at the first row that cannot be
+  /// parsed.
+  template <class T, class F>
+  Result<Nothing> for_each_as(const size_t _batch_size, const F& _f) {
+    if (end()) {
+      return error("End is reached.");
+    }
+
+    for (size_t i = 0; i < _batch_size && !end(); ++i) {
+      auto val = from_stmt<T>(stmt_.get());
+      if (!val) {
+        return error(val.error().what());
+      }
+      _f(std::move(*val));
+      step();
+    }
+
+    return Nothing{};
+  }
+
  private:
   void step() { end_ = (sqlite3_step(stmt_.get()) != SQLITE_ROW); }
 
@@ -0,0 +1,101 @@
+#ifndef SQLGEN_SQLITE_PREPAREDSTATEMENTS_HPP_
+#define SQLGEN_SQLITE_PREPAREDSTATEMENTS_HPP_
+
+#include <sqlite3.h>
+
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "../CacheStats.hpp"
+
+namespace sqlgen::sqlite {
+
+/// Keeps the statements that have been prepared on a single connection, so
+/// that statements that are executed repeatedly only need to be parsed and
+/// planned once. Maps the SQL to the statement. When the cache is full, the
+/// least recently used statement is evicted. It is finalized as soon as no
+/// iterator uses it anymore.
+///
+/// Like the connection it belongs to, this is not thread-safe.
+class PreparedStatements {
+  using StmtPtr = std::shared_ptr<sqlite3_stmt>;
+
+ public:
+  PreparedStatements(const size_t _max_size) : max_size_(_max_size) {}
+
+  ~PreparedStatements() = default;
+
+  /// Whether statements should be cached at all.
+  bool enabled() const noexcept { return max_size_ != 0; }
+
+  /// Returns the statement prepared for _sql, reset and without any bound
+  /// values, and marks it as the most recently used. A statement that is
+  /// still being iterated over cannot be handed out a second time, in which
+  /// case a new one needs to be prepared.
+  std::optional<StmtPtr> find(const std::string& _sql) {
+    const auto it = map_.find(_sql);
+    if (it == map_.end() || it->second->stmt.use_count() > 1) {
+      ++stats_.misses;
+      return std::nullopt;
+    }
+    ++stats_.hits;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    const auto& stmt = it->second->stmt;
+    sqlite3_reset(stmt.get());
+    sqlite3_clear_bindings(stmt.get());
+    return stmt;
+  }
+
+  /// Registers _stmt, which has been prepared for _sql, replacing the
+  /// statement previously prepared for it, if there is one.
+  void insert(const std::string& _sql, const StmtPtr& _stmt) {
+    const auto it = map_.find(_sql);
+    if (it != map_.end()) {
+      it->second->stmt = _stmt;
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return;
+    }
+    entries_.emplace_front(Entry{.sql = _sql, .stmt = _stmt});
+    map_[_sql] = entries_.begin();
+    if (map_.size() <= max_size_) {
+      return;
+    }
+    map_.erase(entries_.back().sql);
+    entries_.pop_back();
+    ++stats_.evictions;
+  }
+
+  /// A snapshot of the hit, miss and eviction counters.
+  CacheStats stats() const {
+    auto stats = stats_;
+    stats.size = map_.size();
+    return stats;
+  }
+
+ private:
+  struct Entry {
+    std::string sql;
+    StmtPtr stmt;
+  };
+
+  using Entries = std::list<Entry>;
+
+  /// The maximum number of prepared statements, 0 meaning none are kept.
+  size_t max_size_;
+
+  /// The statements, with the most recently used in front.
+  Entries entries_;
+
+  /// Maps the SQL to the position of its statement in entries_.
+  std::unordered_map<std::string, Entries::iterator> map_;
+
+  /// The statistics, except for the size.
+  CacheStats stats_;
+};
+
+}  // namespace sqlgen::sqlite
+
+#endif
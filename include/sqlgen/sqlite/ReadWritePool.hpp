@@ -0,0 +1,117 @@
+#ifndef SQLGEN_SQLITE_READWRITEPOOL_HPP_
+#define SQLGEN_SQLITE_READWRITEPOOL_HPP_
+
+#include <sqlite3.h>
+
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include "../ConnectionPool.hpp"
+#include "../ConnectionPoolStats.hpp"
+#include "../Ref.hpp"
+#include "../Result.hpp"
+#include "../Session.hpp"
+#include "Config.hpp"
+#include "Connection.hpp"
+
+namespace sqlgen::sqlite {
+
+/// A pair of connection pools for a single database file: Any number of
+/// read-only connections for the readers and a single connection for the
+/// writers. SQLite allows only one writer at a time anyway, so writers wait
+/// for their turn in the queue of the pool, in the order they arrived,
+/// instead of failing with SQLITE_BUSY. In WAL mode, the readers proceed at
+/// the same time as the writer and each other.
+///
+/// Like ConnectionPool, copies share the same connections.
+class ReadWritePool {
+  using SessionPtr = Ref<Session<Connection>>;
+
+ public:
+  /// _readers configures the pool of read-only connections. The writer uses
+  /// the same acquire timeout. _config is used to open the writer. The
+  /// readers are opened read-only and leave the journal mode, which persists
+  /// in the file, to the writer.
+  ReadWritePool(const ConnectionPoolConfig& _readers, const Config& _config)
+      : writer_(make_writer_config(_readers), check(_config)),
+        readers_(_readers, make_reader_config(_config)) {}
+
+  static Result<ReadWritePool> make(const ConnectionPoolConfig& _readers,
+                                    const Config& _config) noexcept {
+    try {
+      return ReadWritePool(_readers, _config);
+    } catch (std::exception& e) {
+      return error(e.what());
+    }
+  }
+
+  /// Acquires a read-only session. Statements that write fail with
+  /// "attempt to write a readonly database".
+  Result<SessionPtr> reader() noexcept { return readers_.acquire(); }
+
+  template <class Rep, class Period>
+  Result<SessionPtr> reader(
+      const std::chrono::duration<Rep, Period>& _timeout) noexcept {
+    return readers_.acquire(_timeout);
+  }
+
+  /// Acquires the session of the writer, waiting for the writers that have
+  /// arrived earlier.
+  Result<SessionPtr> writer() noexcept { return writer_.acquire(); }
+
+  template <class Rep, class Period>
+  Result<SessionPtr> writer(
+      const std::chrono::duration<Rep, Period>& _timeout) noexcept {
+    return writer_.acquire(_timeout);
+  }
+
+  /// Get statistics on how long readers had to wait for connections.
+  ConnectionPoolStats reader_stats() const { return readers_.stats(); }
+
+  /// Get statistics on how long writers had to wait for their turn.
+  ConnectionPoolStats writer_stats() const { return writer_.stats(); }
+
+ private:
+  /// Each connection to an in-memory database has a database of its own, so
+  /// the readers would not see what has been written.
+  static const Config& check(const Config& _config) {
+    if (_config.fname.empty() || _config.fname == ":memory:") {
+      throw std::runtime_error(
+          "A ReadWritePool requires a database file, because the readers and "
+          "the writer use separate connections.");
+    }
+    return _config;
+  }
+
+  static Config make_reader_config(const Config& _config) {
+    auto config = _config;
+    config.flags &= ~(SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    config.flags |= SQLITE_OPEN_READONLY;
+    config.journal_mode = std::nullopt;
+    return config;
+  }
+
+  static ConnectionPoolConfig make_writer_config(
+      const ConnectionPoolConfig& _readers) {
+    return ConnectionPoolConfig{
+        .size = 1,
+        .num_attempts = _readers.num_attempts,
+        .wait_time_in_seconds = _readers.wait_time_in_seconds,
+        .acquire_timeout = _readers.acquire_timeout};
+  }
+
+ private:
+  /// The single connection that is allowed to write. It is opened first, so
+  /// that the file exists and is in the configured journal mode, before the
+  /// readers are opened.
+  ConnectionPool<Connection> writer_;
+
+  /// The read-only connections.
+  ConnectionPool<Connection> readers_;
+};
+
+}  // namespace sqlgen::sqlite
+
+#endif
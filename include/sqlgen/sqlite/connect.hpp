@@ -3,12 +3,18 @@
 
 #include <string>
 
+#include "Config.hpp"
 #include "Connection.hpp"
 
 namespace sqlgen::sqlite {
 
-inline auto connect(const std::string& _fname = ":memory:") {
-  return Connection::make(_fname);
+inline auto connect(const std::string& _fname = ":memory:",
+                    const size_t _max_prepared_statements = 64) {
+  return Connection::make(_fname, _max_prepared_statements);
+}
+
+inline auto connect(const Config& _config) {
+  return Connection::make(_config);
 }
 
 }  // namespace sqlgen::sqlite
@@ -0,0 +1,68 @@
+#ifndef SQLGEN_SQLITE_FROMSTMT_HPP_
+#define SQLGEN_SQLITE_FROMSTMT_HPP_
+
+#include <sqlite3.h>
+
+#include <rfl.hpp>
+#include <rfl/NamedTuple.hpp>
+#include <rfl/from_named_tuple.hpp>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "../Result.hpp"
+#include "parsing/Parser.hpp"
+
+namespace sqlgen::sqlite {
+
+template <class T, class NamedTupleT>
+struct FromStmt;
+
+/// Decodes the current row of a prepared statement straight into the fields
+/// of T. Numbers are read as numbers, rather than being converted to text by
+/// SQLite and parsed back again.
+template <class T, class... FieldTs>
+struct FromStmt<T, rfl::NamedTuple<FieldTs...>> {
+  Result<T> operator()(sqlite3_stmt* _stmt) const noexcept {
+    constexpr int num_fields = static_cast<int>(sizeof...(FieldTs));
+    const int num_cols = sqlite3_column_count(_stmt);
+    if (num_cols != num_fields) {
+      return error("Expected exactly " + std::to_string(num_fields) +
+                   " fields, but got " + std::to_string(num_cols) + ".");
+    }
+    return [&]<int... _is>(std::integer_sequence<int, _is...>) -> Result<T> {
+      try {
+        return rfl::from_named_tuple<T>(rfl::named_tuple_t<T>(
+            read_field<typename FieldTs::Type>(_stmt, _is,
+                                               FieldTs::name())...));
+      } catch (const std::exception& e) {
+        return error(e.what());
+      }
+    }(std::make_integer_sequence<int, num_fields>());
+  }
+
+ private:
+  template <class FieldType>
+  static FieldType read_field(sqlite3_stmt* _stmt, const int _col,
+                              const std::string_view _name) {
+    const auto value = parsing::ColumnValue{
+        .stmt = _stmt, .col = _col, .type = sqlite3_column_type(_stmt, _col)};
+    auto field = parsing::Parser<std::remove_cvref_t<FieldType>>::read(
+        value.type == SQLITE_NULL ? nullptr : &value);
+    if (!field) {
+      throw std::runtime_error("Failed to parse field '" + std::string(_name) +
+                               "': " + field.error().what());
+    }
+    return std::move(*field);
+  }
+};
+
+template <class T>
+inline const auto from_stmt =
+    FromStmt<std::remove_cvref_t<T>, rfl::named_tuple_t<T>>{};
+
+}  // namespace sqlgen::sqlite
+
+#endif
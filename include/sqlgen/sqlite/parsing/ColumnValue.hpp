@@ -0,0 +1,46 @@
+#ifndef SQLGEN_SQLITE_PARSING_COLUMNVALUE_HPP_
+#define SQLGEN_SQLITE_PARSING_COLUMNVALUE_HPP_
+
+#include <sqlite3.h>
+
+#include <cstdint>
+#include <string_view>
+
+namespace sqlgen::sqlite::parsing {
+
+/// A single non-NULL column of the current row of a prepared statement.
+/// The values are read with the accessor matching their storage class, so
+/// SQLite does not have to convert them to text.
+struct ColumnValue {
+  /// The prepared statement, which must point to a row.
+  sqlite3_stmt* stmt;
+
+  /// The index of the column.
+  int col;
+
+  /// The storage class of the value, like SQLITE_INTEGER or SQLITE_TEXT.
+  int type;
+
+  int64_t as_int64() const noexcept { return sqlite3_column_int64(stmt, col); }
+
+  double as_double() const noexcept { return sqlite3_column_double(stmt, col); }
+
+  /// Points into the buffer owned by the statement, which is valid until
+  /// the statement moves on to the next row.
+  std::string_view as_text() const noexcept {
+    // The pointer must be retrieved before the number of bytes, see the
+    // documentation of sqlite3_column_bytes.
+    const auto ptr =
+        type == SQLITE_BLOB
+            ? static_cast<const char*>(sqlite3_column_blob(stmt, col))
+            : reinterpret_cast<const char*>(sqlite3_column_text(stmt, col));
+    if (!ptr) {
+      return std::string_view();
+    }
+    return std::string_view(ptr, sqlite3_column_bytes(stmt, col));
+  }
+};
+
+}  // namespace sqlgen::sqlite::parsing
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef SQLGEN_SQLITE_PARSING_PARSER_HPP_
+#define SQLGEN_SQLITE_PARSING_PARSER_HPP_
+
+#include "ColumnValue.hpp"
+#include "Parser_base.hpp"
+#include "Parser_default.hpp"
+#include "Parser_optional.hpp"
+#include "Parser_reflection_type.hpp"
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef SQLGEN_SQLITE_PARSING_PARSER_BASE_HPP_
+#define SQLGEN_SQLITE_PARSING_PARSER_BASE_HPP_
+
+namespace sqlgen::sqlite::parsing {
+
+template <class T>
+struct Parser;
+
+}
+
+#endif
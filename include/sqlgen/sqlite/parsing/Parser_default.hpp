@@ -0,0 +1,89 @@
+#ifndef SQLGEN_SQLITE_PARSING_PARSER_DEFAULT_HPP_
+#define SQLGEN_SQLITE_PARSING_PARSER_DEFAULT_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "../../Result.hpp"
+#include "../../parsing/Parser.hpp"
+#include "ColumnValue.hpp"
+#include "Parser_base.hpp"
+
+namespace sqlgen::sqlite::parsing {
+
+template <class T>
+struct Parser {
+  using Type = std::remove_cvref_t<T>;
+
+  static Result<T> read(const ColumnValue* _v) noexcept {
+    if constexpr (std::is_same_v<Type, bool>) {
+      if (_v && _v->type == SQLITE_INTEGER) {
+        return _v->as_int64() != 0;
+      }
+      if (_v && _v->type == SQLITE_FLOAT) {
+        return _v->as_double() != 0.0;
+      }
+
+    } else if constexpr (std::is_integral_v<Type>) {
+      if (_v && _v->type == SQLITE_INTEGER) {
+        return read_integer(_v->as_int64());
+      }
+      if (_v && _v->type == SQLITE_FLOAT) {
+        return read_integer(_v->as_double());
+      }
+
+    } else if constexpr (std::is_floating_point_v<Type>) {
+      if (_v && _v->type == SQLITE_INTEGER) {
+        return static_cast<Type>(_v->as_int64());
+      }
+      if (_v && _v->type == SQLITE_FLOAT) {
+        return static_cast<Type>(_v->as_double());
+      }
+    }
+
+    // Everything else, like strings, enums and timestamps, is stored as text
+    // and parsed just like for any other database.
+    return sqlgen::parsing::read_value<Type>(
+        _v ? std::make_optional(_v->as_text())
+           : std::optional<std::string_view>());
+  }
+
+ private:
+  /// SQLite stores all integers as 64-bit integers, so they may be out of
+  /// range for narrower types.
+  static Result<T> read_integer(const int64_t _i) noexcept {
+    if (!std::in_range<Type>(_i)) {
+      return error("Value " + std::to_string(_i) + " is out of range for " +
+                   type_description() + ".");
+    }
+    return static_cast<Type>(_i);
+  }
+
+  /// Reals, for instance the result of AVG(...), are truncated towards zero,
+  /// as long as the result is in range. Converting anything else to an
+  /// integer would be undefined behaviour.
+  static Result<T> read_integer(const double _d) noexcept {
+    const auto t = std::trunc(_d);
+    if (!(t >= static_cast<double>(std::numeric_limits<Type>::min()) &&
+          t < static_cast<double>(std::numeric_limits<Type>::max()) + 1.0)) {
+      return error("Value " + std::to_string(_d) + " is out of range for " +
+                   type_description() + ".");
+    }
+    return static_cast<Type>(t);
+  }
+
+  static std::string type_description() {
+    return std::string(std::is_signed_v<Type> ? "a signed" : "an unsigned") +
+           " integer with " + std::to_string(8 * sizeof(Type)) + " bits";
+  }
+};
+
+}  // namespace sqlgen::sqlite::parsing
+
+#endif
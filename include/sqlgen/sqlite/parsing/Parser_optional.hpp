@@ -0,0 +1,28 @@
+#ifndef SQLGEN_SQLITE_PARSING_PARSER_OPTIONAL_HPP_
+#define SQLGEN_SQLITE_PARSING_PARSER_OPTIONAL_HPP_
+
+#include <optional>
+#include <type_traits>
+
+#include "../../Result.hpp"
+#include "ColumnValue.hpp"
+#include "Parser_base.hpp"
+
+namespace sqlgen::sqlite::parsing {
+
+template <class T>
+struct Parser<std::optional<T>> {
+  static Result<std::optional<T>> read(const ColumnValue* _v) noexcept {
+    if (!_v) {
+      return std::optional<T>();
+    }
+    return Parser<std::remove_cvref_t<T>>::read(_v).transform(
+        [](auto&& _t) -> std::optional<T> {
+          return std::make_optional<T>(std::move(_t));
+        });
+  }
+};
+
+}  // namespace sqlgen::sqlite::parsing
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef SQLGEN_SQLITE_PARSING_PARSER_REFLECTION_TYPE_HPP_
+#define SQLGEN_SQLITE_PARSING_PARSER_REFLECTION_TYPE_HPP_
+
+#include <type_traits>
+
+#include "../../Result.hpp"
+#include "../../transpilation/has_reflection_method.hpp"
+#include "ColumnValue.hpp"
+#include "Parser_base.hpp"
+
+namespace sqlgen::sqlite::parsing {
+
+/// Wrappers around numbers, like PrimaryKey<int>, are unwrapped, so that the
+/// number can be read without the detour via text. All other wrappers are
+/// handled by the default parser.
+template <class T>
+  requires transpilation::has_reflection_method<std::remove_cvref_t<T>> &&
+           std::is_arithmetic_v<std::remove_cvref_t<
+               typename std::remove_cvref_t<T>::ReflectionType>>
+struct Parser<T> {
+  using Type = std::remove_cvref_t<T>;
+
+  static Result<T> read(const ColumnValue* _v) noexcept {
+    return Parser<std::remove_cvref_t<typename Type::ReflectionType>>::read(_v)
+        .transform([](auto&& _t) { return T(std::move(_t)); });
+  }
+};
+
+}  // namespace sqlgen::sqlite::parsing
+
+#endif
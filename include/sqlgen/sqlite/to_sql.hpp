@@ -2,8 +2,10 @@
 #define SQLGEN_SQLITE_TO_SQL_HPP_
 
 #include <string>
+#include <vector>
 
 #include "../dynamic/Statement.hpp"
+#include "../dynamic/Value.hpp"
 #include "../sqlgen_api.hpp"
 #include "../transpilation/to_sql.hpp"
 
@@ -12,6 +14,13 @@ namespace sqlgen::sqlite {
 /// Transpiles a dynamic general SQL statement to the sqlite dialect.
 std::string SQLGEN_API to_sql_impl(const dynamic::Statement& _stmt) noexcept;
 
+/// Like to_sql_impl(_stmt), but the literals in conditions and SET clauses are
+/// replaced by numbered placeholders and appended to _params, so that they
+/// can be bound instead of being escaped and inlined.
+std::string SQLGEN_API
+to_sql_impl(const dynamic::Statement& _stmt,
+            std::vector<dynamic::Value>* _params) noexcept;
+
 /// Transpiles any  SQL statement to the sqlite dialect.
 template <class T>
 std::string to_sql(const T& _t) noexcept {
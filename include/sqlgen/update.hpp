@@ -6,6 +6,8 @@
 
 #include "Ref.hpp"
 #include "Result.hpp"
+#include "internal/execute_statement.hpp"
+#include "internal/invalidate_cache.hpp"
 #include "is_connection.hpp"
 #include "transpilation/to_update.hpp"
 #include "where.hpp"
@@ -19,9 +21,11 @@ Result<Ref<Connection>> update_impl(const Ref<Connection>& _conn,
                                     const WhereType& _where) {
   const auto query =
       transpilation::to_update<ValueType, SetsType, WhereType>(_sets, _where);
-  return _conn->execute(_conn->to_sql(query)).transform([&](const auto&) {
-    return _conn;
-  });
+  const auto res = internal::execute_statement(_conn, query);
+
+  internal::invalidate_cache(_conn, query.table.name);
+
+  return res.transform([&](const auto&) { return _conn; });
 }
 
 template <class ValueType, class SetsType, class WhereType, class Connection>
@@ -12,8 +12,10 @@
 
 #include "Ref.hpp"
 #include "Result.hpp"
+#include "binary.hpp"
 #include "dynamic/Write.hpp"
 #include "internal/batch_size.hpp"
+#include "internal/invalidate_cache.hpp"
 #include "internal/to_str_vec.hpp"
 #include "is_connection.hpp"
 #include "transpilation/to_create_table.hpp"
@@ -23,14 +25,15 @@ namespace sqlgen {
 
 template <class ItBegin, class ItEnd, class Connection>
   requires is_connection<Connection>
-Result<Ref<Connection>> write(const Ref<Connection>& _conn, ItBegin _begin,
-                              ItEnd _end) noexcept {
+Result<Ref<Connection>> write_impl(const Ref<Connection>& _conn,
+                                   ItBegin _begin, ItEnd _end,
+                                   const bool _binary) noexcept {
   using T =
       std::remove_cvref_t<typename std::iterator_traits<ItBegin>::value_type>;
 
   const auto start_write = [&](const auto&) -> Result<Nothing> {
-    const auto write_stmt =
-        transpilation::to_insert_or_write<T, dynamic::Write>();
+    auto write_stmt = transpilation::to_insert_or_write<T, dynamic::Write>();
+    write_stmt.binary = _binary;
     return _conn->start_write(write_stmt);
   };
 
@@ -48,41 +51,78 @@ Result<Ref<Connection>> write(const Ref<Connection>& _conn, ItBegin _begin,
 
   const auto create_table_stmt = transpilation::to_create_table<T>();
 
-  return _conn->execute(_conn->to_sql(create_table_stmt))
-      .and_then(start_write)
-      .and_then(write)
-      .and_then(end_write)
-      .transform([&](const auto&) { return _conn; });
+  const auto res = _conn->execute(_conn->to_sql(create_table_stmt))
+                       .and_then(start_write)
+                       .and_then(write)
+                       .and_then(end_write);
+
+  internal::invalidate_cache(_conn, create_table_stmt.table.name);
+
+  return res.transform([&](const auto&) { return _conn; });
 }
 
 template <class ItBegin, class ItEnd, class Connection>
   requires is_connection<Connection>
-Result<Ref<Connection>> write(const Result<Ref<Connection>>& _res,
-                              ItBegin _begin, ItEnd _end) noexcept {
-  return _res.and_then(
-      [&](const auto& _conn) { return write(_conn, _begin, _end); });
+Result<Ref<Connection>> write_impl(const Result<Ref<Connection>>& _res,
+                                   ItBegin _begin, ItEnd _end,
+                                   const bool _binary) noexcept {
+  return _res.and_then([&](const auto& _conn) {
+    return write_impl(_conn, _begin, _end, _binary);
+  });
 }
 
 template <class ContainerType>
-auto write(const auto& _conn, const ContainerType& _container) noexcept {
+auto write_container(const auto& _conn, const ContainerType& _container,
+                     const bool _binary) noexcept {
   if constexpr (std::ranges::input_range<std::remove_cvref_t<ContainerType>>) {
-    return write(_conn, _container.begin(), _container.end());
+    return write_impl(_conn, _container.begin(), _container.end(), _binary);
   } else {
-    return write(_conn, &_container, &_container + 1);
+    return write_impl(_conn, &_container, &_container + 1, _binary);
   }
 }
 
+template <class ContainerType>
+auto write_container(const auto& _conn,
+                     const std::reference_wrapper<ContainerType>& _data,
+                     const bool _binary) noexcept {
+  return write_container(_conn, _data.get(), _binary);
+}
+
+template <class ItBegin, class ItEnd, class Connection>
+  requires is_connection<Connection>
+Result<Ref<Connection>> write(const Ref<Connection>& _conn, ItBegin _begin,
+                              ItEnd _end) noexcept {
+  return write_impl(_conn, _begin, _end, false);
+}
+
+template <class ItBegin, class ItEnd, class Connection>
+  requires is_connection<Connection>
+Result<Ref<Connection>> write(const Result<Ref<Connection>>& _res,
+                              ItBegin _begin, ItEnd _end) noexcept {
+  return write_impl(_res, _begin, _end, false);
+}
+
+template <class ContainerType>
+auto write(const auto& _conn, const ContainerType& _container) noexcept {
+  return write_container(_conn, _container, false);
+}
+
 template <class ContainerType>
 auto write(const auto& _conn,
            const std::reference_wrapper<ContainerType>& _data) {
-  return write(_conn, _data.get());
+  return write_container(_conn, _data, false);
 }
 
 template <class ContainerType>
 struct Write {
-  auto operator()(const auto& _conn) const { return write(_conn, data_); }
+  auto operator()(const auto& _conn) const {
+    return write_container(_conn, data_, binary_);
+  }
 
   ContainerType data_;
+
+  /// Whether the data is transferred in a binary format, see sqlgen::binary.
+  bool binary_ = false;
 };
 
 template <class ContainerType>
@@ -1,6 +1,6 @@
 #include "sqlgen/mysql/Connection.hpp"
 
-#include <cstring>
+#include <algorithm>
 #include <ranges>
 #include <rfl.hpp>
 #include <sstream>
@@ -20,59 +20,56 @@ Connection::Connection(const Credentials& _credentials)
 Connection::~Connection() = default;
 
 Result<Nothing> Connection::actual_insert(
-    const std::vector<std::vector<std::optional<std::string>>>& _data,
-    MYSQL_STMT* _stmt) const noexcept {
-  const auto num_params = static_cast<size_t>(mysql_stmt_param_count(_stmt));
-
-  std::vector<MYSQL_BIND> bind(num_params);
-
-  std::vector<long unsigned int> lengths(num_params);
-  std::vector<my_bool> is_null(num_params);
-
-  for (const auto& row : _data) {
-    memset(bind.data(), 0, sizeof(MYSQL_BIND) * num_params);
-
-    if (row.size() != num_params) {
-      return error("Expected " + std::to_string(num_params) + " fields, got " +
-                   std::to_string(row.size()) + ".");
-    }
-
-    auto buffer = row;
-
-    for (size_t i = 0; i < num_params; ++i) {
-      if (buffer[i]) {
-        lengths[i] = static_cast<long unsigned int>(row[i]->size());
-        is_null[i] = 0;
-
-        bind[i].buffer_type = MYSQL_TYPE_STRING;
-        bind[i].buffer = &((*buffer[i])[0]);
-        bind[i].buffer_length = lengths[i];
-        bind[i].is_null = &(is_null[i]);
-        bind[i].length = &(lengths[i]);
-      } else {
-        lengths[i] = 0;
-        is_null[i] = 1;
-
-        bind[i].buffer_type = MYSQL_TYPE_NULL;
-        bind[i].buffer = nullptr;
-        bind[i].buffer_length = 0;
-        bind[i].is_null = &(is_null[i]);
-        bind[i].length = 0;
-      }
+    const std::variant<dynamic::Insert, dynamic::Write>& _stmt,
+    const std::vector<std::vector<std::optional<std::string>>>& _data)
+    const noexcept {
+  using InsertOrWrite = std::variant<dynamic::Insert, dynamic::Write>;
+
+  const auto with_num_rows = [&](const size_t _num_rows) {
+    return std::visit(
+        [&](auto _s) -> InsertOrWrite {
+          _s.num_rows = _num_rows;
+          return _s;
+        },
+        _stmt);
+  };
+
+  const auto num_cols =
+      std::visit([](const auto& _s) { return _s.columns.size(); }, _stmt);
+
+  const auto max_rows = max_rows_per_insert(num_cols);
+
+  const auto num_full = _data.size() / max_rows;
+
+  if (num_full != 0) {
+    const auto res =
+        prepare_statement(with_num_rows(max_rows))
+            .and_then([&](auto&& _stmt_ptr) -> Result<Nothing> {
+              for (size_t i = 0; i < num_full; ++i) {
+                const auto inserted =
+                    insert_rows(_data, i * max_rows, max_rows, _stmt_ptr.get());
+                if (!inserted) {
+                  return inserted;
+                }
+              }
+              return Nothing{};
+            });
+    if (!res) {
+      return res;
     }
+  }
 
-    auto err = mysql_stmt_bind_param(_stmt, bind.data());
-    if (err) {
-      return make_error(conn_);
-    }
+  const auto num_remaining = _data.size() % max_rows;
 
-    err = mysql_stmt_execute(_stmt);
-    if (err) {
-      return make_error(conn_);
-    }
+  if (num_remaining == 0) {
+    return Nothing{};
   }
 
-  return Nothing{};
+  return prepare_statement(with_num_rows(num_remaining))
+      .and_then([&](auto&& _stmt_ptr) {
+        return insert_rows(_data, num_full * max_rows, num_remaining,
+                           _stmt_ptr.get());
+      });
 }
 
 Result<Nothing> Connection::begin_transaction() noexcept {
@@ -89,11 +86,69 @@ Result<Nothing> Connection::insert_impl(
     const dynamic::Insert& _stmt,
     const std::vector<std::vector<std::optional<std::string>>>&
         _data) noexcept {
-  if (_data.size() == 0) {
-    return Nothing{};
+  return actual_insert(_stmt, _data);
+}
+
+Result<Nothing> Connection::insert_rows(
+    const std::vector<std::vector<std::optional<std::string>>>& _data,
+    const size_t _begin, const size_t _num_rows,
+    MYSQL_STMT* _stmt) const noexcept {
+  const auto num_params = static_cast<size_t>(mysql_stmt_param_count(_stmt));
+
+  const auto num_fields = num_params / _num_rows;
+
+  // Value-initialization sets all of the fields to zero.
+  std::vector<MYSQL_BIND> bind(num_params);
+
+  std::vector<long unsigned int> lengths(num_params);
+  std::vector<my_bool> is_null(num_params);
+
+  size_t ix = 0;
+
+  for (size_t i = _begin; i < _begin + _num_rows; ++i) {
+    const auto& row = _data[i];
+
+    if (row.size() != num_fields) {
+      return error("Expected " + std::to_string(num_fields) + " fields, got " +
+                   std::to_string(row.size()) + ".");
+    }
+
+    for (const auto& field : row) {
+      if (field) {
+        lengths[ix] = static_cast<long unsigned int>(field->size());
+        is_null[ix] = 0;
+
+        // MySQL does not write to the buffers of input parameters.
+        bind[ix].buffer_type = MYSQL_TYPE_STRING;
+        bind[ix].buffer = const_cast<char*>(field->data());
+        bind[ix].buffer_length = lengths[ix];
+        bind[ix].is_null = &(is_null[ix]);
+        bind[ix].length = &(lengths[ix]);
+      } else {
+        lengths[ix] = 0;
+        is_null[ix] = 1;
+
+        bind[ix].buffer_type = MYSQL_TYPE_NULL;
+        bind[ix].buffer = nullptr;
+        bind[ix].buffer_length = 0;
+        bind[ix].is_null = &(is_null[ix]);
+        bind[ix].length = 0;
+      }
+      ++ix;
+    }
+  }
+
+  auto err = mysql_stmt_bind_param(_stmt, bind.data());
+  if (err) {
+    return make_error(conn_);
+  }
+
+  err = mysql_stmt_execute(_stmt);
+  if (err) {
+    return make_error(conn_);
   }
-  return prepare_statement(_stmt).and_then(
-      [&](auto&& _stmt_ptr) { return actual_insert(_data, _stmt_ptr.get()); });
+
+  return Nothing{};
 }
 
 rfl::Result<Ref<Connection>> Connection::make(
@@ -125,6 +180,14 @@ typename Connection::ConnPtr Connection::make_conn(
   return ConnPtr::make(shared_ptr).value();
 }
 
+size_t Connection::max_rows_per_insert(const size_t _num_cols) noexcept {
+  constexpr size_t max_params = 65535;
+  return std::max<size_t>(
+      std::min<size_t>(max_params / std::max<size_t>(_num_cols, 1),
+                       SQLGEN_ROWS_PER_INSERT),
+      1);
+}
+
 Result<Connection::StmtPtr> Connection::prepare_statement(
     const std::variant<dynamic::Insert, dynamic::Write>& _stmt) const noexcept {
   const auto sql = std::visit(to_sql_impl, _stmt);
@@ -137,6 +200,13 @@ Result<Connection::StmtPtr> Connection::prepare_statement(
   return stmt_ptr;
 }
 
+Result<Nothing> Connection::ping() noexcept {
+  if (mysql_ping(conn_.get())) {
+    return make_error(conn_);
+  }
+  return Nothing{};
+}
+
 Result<Ref<Iterator>> Connection::read_impl(
     const rfl::Variant<dynamic::SelectFrom, dynamic::Union>& _query) {
   const auto sql =
@@ -158,15 +228,17 @@ Result<Ref<Iterator>> Connection::read_impl(
 Result<Nothing> Connection::rollback() noexcept { return execute("ROLLBACK;"); }
 
 Result<Nothing> Connection::start_write(const dynamic::Write& _write_stmt) {
-  if (stmt_) {
+  if (write_) {
     return error(
         "A write operation has already been launched. You need to call "
         ".end_write() before you can start another.");
   }
+  // The statements are prepared once we know how many rows there are, but
+  // we want to know right away, if the statement is invalid.
   return begin_transaction()
       .and_then([&](auto&&) { return prepare_statement(_write_stmt); })
-      .transform([&](auto&& _stmt) {
-        stmt_ = _stmt;
+      .transform([&](auto&&) {
+        write_ = _write_stmt;
         return Nothing{};
       })
       .or_else([&](auto&& _err) {
@@ -181,20 +253,20 @@ std::string Connection::to_sql(const dynamic::Statement& _stmt) noexcept {
 
 Result<Nothing> Connection::write_impl(
     const std::vector<std::vector<std::optional<std::string>>>& _data) {
-  if (!stmt_) {
+  if (!write_) {
     return error(
         " You need to call .start_write(...) before you can call "
         ".write(...).");
   }
-  return actual_insert(_data, stmt_.get()).or_else([&](const auto& _err) {
+  return actual_insert(*write_, _data).or_else([&](const auto& _err) {
     rollback();
-    stmt_ = nullptr;
+    write_ = std::nullopt;
     return error(_err.what());
   });
 }
 
 Result<Nothing> Connection::end_write() {
-  stmt_ = nullptr;
+  write_ = std::nullopt;
   return commit();
 }
 
@@ -43,4 +43,30 @@ Result<std::vector<std::vector<std::optional<std::string>>>> Iterator::next(
   return vec;
 }
 
+Result<Nothing> Iterator::read_row(
+    std::vector<std::optional<std::string_view>>* _row) {
+  MYSQL_ROW row = mysql_fetch_row(res_.get());
+
+  if (!row) {
+    const auto err = mysql_error(conn_.get());
+    if (*err) {
+      return error(err);
+    }
+    end_ = true;
+    return Nothing{};
+  }
+
+  const unsigned long* lengths = mysql_fetch_lengths(res_.get());
+
+  for (size_t j = 0; j < _row->size(); ++j) {
+    if (row[j]) {
+      (*_row)[j] = std::string_view(row[j], lengths[j]);
+    } else {
+      (*_row)[j] = std::nullopt;
+    }
+  }
+
+  return Nothing{};
+}
+
 }  // namespace sqlgen::mysql
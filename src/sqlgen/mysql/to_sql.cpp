@@ -573,11 +573,16 @@ std::string insert_or_write_to_sql(const InsertOrWrite& _stmt) noexcept {
       internal::collect::vector(_stmt.columns | transform(wrap_in_quotes)));
   stream << ")";
 
-  stream << " VALUES (";
-  stream << internal::strings::join(
-      ", ",
-      internal::collect::vector(_stmt.columns | transform(to_questionmark)));
-  stream << ")";
+  const auto questionmarks =
+      internal::collect::vector(_stmt.columns | transform(to_questionmark));
+  const auto placeholders =
+      "(" + internal::strings::join(", ", questionmarks) + ")";
+
+  stream << " VALUES " << placeholders;
+  for (size_t i = 1; i < _stmt.num_rows; ++i) {
+    stream << ", " << placeholders;
+  }
+
   if constexpr (std::is_same_v<InsertOrWrite, dynamic::Insert>) {
     if (_stmt.or_replace) {
       stream << " ON DUPLICATE KEY UPDATE ";
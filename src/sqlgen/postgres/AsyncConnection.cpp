@@ -0,0 +1,351 @@
+#include "sqlgen/postgres/AsyncConnection.hpp"
+
+#ifdef __linux__
+
+#include <sys/epoll.h>
+
+#include <concepts>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include "sqlgen/internal/CacheRegistry.hpp"
+
+namespace sqlgen::postgres {
+
+AsyncConnection::AsyncConnection(const Conn& _conn, const Ref<EventLoop>& _loop,
+                                 const Credentials& _credentials)
+    : conn_(_conn),
+      loop_(_loop),
+      socket_(PQsocket(_conn.ptr())),
+      binary_results_(_credentials.binary_results),
+      prepared_statements_(_credentials.max_prepared_statements) {
+  if (socket_ < 0) {
+    throw std::runtime_error("The connection has no socket.");
+  }
+  if (PQsetnonblocking(conn_.ptr(), 1) != 0) {
+    throw std::runtime_error(
+        std::string("Could not switch to nonblocking mode: ") +
+        PQerrorMessage(conn_.ptr()));
+  }
+  Result<Nothing> res = Nothing{};
+  run_in_loop([&]() {
+    res = loop_->add(socket_, EPOLLIN, [this](const uint32_t _events) {
+      handle_events(_events);
+    });
+  });
+  res.value();
+}
+
+AsyncConnection::~AsyncConnection() {
+  run_in_loop([this]() {
+    loop_->remove(socket_);
+    fail_all("The connection was closed.");
+  });
+}
+
+std::future<Result<Nothing>> AsyncConnection::execute(const std::string& _sql) {
+  auto promise = std::make_shared<std::promise<Result<Nothing>>>();
+  auto future = promise->get_future();
+  submit(Op{.sql = _sql,
+            .callback = [promise](Result<PostgresV2Result> _res) {
+              promise->set_value(
+                  _res.transform([](const auto&) { return Nothing{}; }));
+            }});
+  return future;
+}
+
+std::future<Result<Nothing>> AsyncConnection::execute_rows(
+    std::string _sql, Rows _rows, const std::optional<std::string>& _table) {
+  auto promise = std::make_shared<std::promise<Result<Nothing>>>();
+  auto future = promise->get_future();
+
+  if (_rows.size() == 0) {
+    promise->set_value(Nothing{});
+    return future;
+  }
+
+  submit(Op{.sql = std::move(_sql),
+            .rows = std::move(_rows),
+            .callback = [promise, _table](Result<PostgresV2Result> _res) {
+              if (_table) {
+                internal::CacheRegistry::instance().invalidate(*_table);
+              }
+              promise->set_value(
+                  _res.transform([](const auto&) { return Nothing{}; }));
+            }});
+
+  return future;
+}
+
+std::future<Result<Nothing>> AsyncConnection::execute_statement(
+    const dynamic::Statement& _stmt) {
+  std::vector<dynamic::Value> values;
+  auto sql = to_sql_impl(_stmt, &values);
+
+  // Like update(...) and delete_from(...), we invalidate the cached reads of
+  // the table that is written to.
+  const auto table =
+      _stmt.visit([](const auto& _s) -> std::optional<std::string> {
+        if constexpr (requires {
+                        { _s.table.name } -> std::convertible_to<std::string>;
+                      }) {
+          return _s.table.name;
+        } else {
+          return std::nullopt;
+        }
+      });
+
+  if (values.empty()) {
+    auto promise = std::make_shared<std::promise<Result<Nothing>>>();
+    auto future = promise->get_future();
+    submit(Op{.sql = std::move(sql),
+              .callback = [promise, table](Result<PostgresV2Result> _res) {
+                if (table) {
+                  internal::CacheRegistry::instance().invalidate(*table);
+                }
+                promise->set_value(
+                    _res.transform([](const auto&) { return Nothing{}; }));
+              }});
+    return future;
+  }
+
+  return execute_rows(std::move(sql), Rows{Connection::to_params(values)},
+                      table);
+}
+
+void AsyncConnection::fail_all(const std::string& _msg) {
+  auto ops = std::move(ops_);
+  ops_.clear();
+  stage_ = Stage::idle;
+  result_ = std::nullopt;
+  error_ = std::nullopt;
+  for (auto& op : ops) {
+    if (op.callback) {
+      op.callback(error(_msg));
+    }
+  }
+}
+
+void AsyncConnection::finish_command() {
+  if (error_) {
+    finish_op(error(*error_));
+    return;
+  }
+
+  auto& op = ops_.front();
+
+  if (stage_ == Stage::prepare) {
+    if (prepared_statements_.enabled()) {
+      const auto evicted = prepared_statements_.insert(op.sql, name_);
+      if (evicted) {
+        ops_.push_back(Op{.sql = "DEALLOCATE " + *evicted});
+      }
+    }
+    stage_ = Stage::execute;
+    row_ix_ = 0;
+    send_command();
+    return;
+  }
+
+  if (op.rows && ++row_ix_ < op.rows->size()) {
+    send_command();
+    return;
+  }
+
+  if (!result_) {
+    finish_op(error("The query did not return a result."));
+    return;
+  }
+
+  auto res = std::move(*result_);
+  finish_op(std::move(res));
+}
+
+void AsyncConnection::finish_op(Result<PostgresV2Result> _res) {
+  auto op = std::move(ops_.front());
+  ops_.pop_front();
+  stage_ = Stage::idle;
+  result_ = std::nullopt;
+  error_ = std::nullopt;
+  if (op.callback) {
+    op.callback(std::move(_res));
+  }
+  start_next();
+}
+
+void AsyncConnection::flush() {
+  const int res = PQflush(conn_.ptr());
+  if (res < 0) {
+    broken_ = PQerrorMessage(conn_.ptr());
+    fail_all(*broken_);
+    return;
+  }
+  const bool want_write = res == 1;
+  if (want_write != want_write_) {
+    want_write_ = want_write;
+    loop_->modify(socket_, want_write ? EPOLLIN | EPOLLOUT : EPOLLIN);
+  }
+}
+
+void AsyncConnection::handle_events(const uint32_t _events) {
+  if (_events & EPOLLOUT) {
+    flush();
+  }
+
+  if (!(_events & (EPOLLIN | EPOLLERR | EPOLLHUP))) {
+    return;
+  }
+
+  if (!PQconsumeInput(conn_.ptr())) {
+    broken_ = PQerrorMessage(conn_.ptr());
+    fail_all(*broken_);
+    loop_->remove(socket_);
+    return;
+  }
+
+  // Notifications are not handled by this connection.
+  PGnotify* notify = nullptr;
+  while ((notify = PQnotifies(conn_.ptr())) != nullptr) {
+    PQfreemem(notify);
+  }
+
+  while (stage_ != Stage::idle && !PQisBusy(conn_.ptr())) {
+    PGresult* res = PQgetResult(conn_.ptr());
+
+    if (!res) {
+      finish_command();
+      continue;
+    }
+
+    const auto status = PQresultStatus(res);
+    if (status != PGRES_COMMAND_OK && status != PGRES_TUPLES_OK) {
+      if (!error_) {
+        error_ = std::string("Query execution failed: ") +
+                 PQresultErrorMessage(res);
+
+        // 26000 is invalid_sql_statement_name, the statement must have been
+        // deallocated behind our back.
+        const char* sqlstate = PQresultErrorField(res, PG_DIAG_SQLSTATE);
+        if (sqlstate && std::string_view(sqlstate) == "26000") {
+          prepared_statements_.invalidate(ops_.front().sql);
+        }
+      }
+      PQclear(res);
+    } else {
+      result_ = PostgresV2Result(res);
+    }
+  }
+}
+
+Result<PostgresV2Result> AsyncConnection::make_error() const {
+  return error(std::string("Query execution failed: ") +
+               PQerrorMessage(conn_.ptr()));
+}
+
+Result<Ref<AsyncConnection>> AsyncConnection::make(
+    const Credentials& _credentials, const Ref<EventLoop>& _loop) noexcept {
+  return PostgresV2Connection::make(_credentials.to_str(),
+                                    _credentials.notice_handler)
+      .and_then([&](auto&& _conn) -> Result<Ref<AsyncConnection>> {
+        try {
+          return Ref<AsyncConnection>::make(_conn, _loop, _credentials);
+        } catch (const std::exception& e) {
+          return error(e.what());
+        }
+      });
+}
+
+void AsyncConnection::run_in_loop(const std::function<void()>& _f) {
+  if (loop_->in_loop_thread()) {
+    _f();
+    return;
+  }
+  std::promise<void> done;
+  loop_->post([&]() {
+    _f();
+    done.set_value();
+  });
+  done.get_future().wait();
+}
+
+void AsyncConnection::send_command() {
+  const auto& op = ops_.front();
+
+  int sent = 0;
+
+  if (!op.rows) {
+    sent = PQsendQuery(conn_.ptr(), op.sql.c_str());
+
+  } else if (stage_ == Stage::prepare) {
+    const auto num_params = static_cast<int>(op.rows->at(0).size());
+    sent = PQsendPrepare(conn_.ptr(), name_.c_str(), op.sql.c_str(),
+                         num_params, nullptr);
+
+  } else {
+    const auto& row = op.rows->at(row_ix_);
+    std::vector<const char*> param_values(row.size());
+    for (size_t i = 0; i < row.size(); ++i) {
+      param_values[i] = row[i] ? row[i]->c_str() : nullptr;
+    }
+    sent = PQsendQueryPrepared(conn_.ptr(), name_.c_str(),
+                               static_cast<int>(row.size()),
+                               param_values.data(), nullptr, nullptr,
+                               op.result_format);
+  }
+
+  if (!sent) {
+    finish_op(make_error());
+    return;
+  }
+
+  flush();
+}
+
+void AsyncConnection::start_next() {
+  if (stage_ != Stage::idle || ops_.empty()) {
+    return;
+  }
+
+  if (broken_) {
+    fail_all(*broken_);
+    return;
+  }
+
+  const auto& op = ops_.front();
+
+  if (!op.rows) {
+    stage_ = Stage::execute;
+    send_command();
+    return;
+  }
+
+  const auto name = prepared_statements_.enabled()
+                        ? prepared_statements_.find(op.sql)
+                        : std::nullopt;
+
+  if (name) {
+    name_ = *name;
+    stage_ = Stage::execute;
+    row_ix_ = 0;
+  } else {
+    // The unnamed statement is replaced whenever another one is prepared, so
+    // it never needs to be deallocated.
+    name_ = prepared_statements_.enabled() ? prepared_statements_.make_name()
+                                           : "";
+    stage_ = Stage::prepare;
+  }
+
+  send_command();
+}
+
+void AsyncConnection::submit(Op _op) {
+  loop_->post([this, op = std::move(_op)]() mutable {
+    ops_.push_back(std::move(op));
+    start_next();
+  });
+}
+
+}  // namespace sqlgen::postgres
+
+#endif
@@ -1,24 +1,42 @@
 #include "sqlgen/postgres/Connection.hpp"
 
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <poll.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdint>
+#include <iomanip>
 #include <ranges>
 #include <rfl.hpp>
 #include <sstream>
 #include <stdexcept>
+#include <string_view>
 
 #include "sqlgen/internal/collect/vector.hpp"
-#include "sqlgen/internal/random.hpp"
 #include "sqlgen/internal/strings/strings.hpp"
 #include "sqlgen/postgres/Iterator.hpp"
 #include "sqlgen/postgres/PostgresV2Result.hpp"
 
 namespace sqlgen::postgres {
 
-Connection::Connection(const Conn& _conn) : conn_(_conn) {}
+Connection::Connection(const Conn& _conn, const Credentials& _credentials)
+    : conn_(_conn),
+      binary_results_(_credentials.binary_results),
+      fetch_size_(_credentials.fetch_size),
+      prefetch_(_credentials.prefetch),
+      stream_ranges_(_credentials.stream_ranges),
+      prepared_statements_(_credentials.max_prepared_statements) {}
 
 Connection::Connection(const Credentials& _credentials)
-    : conn_(PostgresV2Connection::make(_credentials.to_str(),
-                                       _credentials.notice_handler)
-                .value()) {}
+    : Connection(PostgresV2Connection::make(_credentials.to_str(),
+                                            _credentials.notice_handler)
+                     .value(),
+                 _credentials) {}
 
 Result<Nothing> Connection::begin_transaction() noexcept {
   return execute("BEGIN TRANSACTION;");
@@ -32,15 +50,67 @@ Result<Nothing> Connection::execute(const std::string& _sql) noexcept {
   });
 }
 
+Result<Nothing> Connection::execute_statement(
+    const dynamic::Statement& _stmt) noexcept {
+  std::vector<dynamic::Value> values;
+  const auto sql = to_sql_impl(_stmt, &values);
+  if (values.empty()) {
+    return execute(sql);
+  }
+  return execute_params(sql, to_params(values));
+}
+
 Result<Nothing> Connection::execute_params(
     const std::string& _sql,
     const std::vector<std::optional<std::string>>& _params) noexcept {
-  return PostgresV2Result::make(_sql, conn_, _params).transform([](auto&&) {
-    return Nothing{};
-  });
+  if (!prepared_statements_.enabled()) {
+    return PostgresV2Result::make(_sql, conn_, _params).transform([](auto&&) {
+      return Nothing{};
+    });
+  }
+
+  return prepare(_sql, _params.size())
+      .and_then([&](const auto& _name) -> Result<Nothing> {
+        std::vector<const char*> param_values(_params.size());
+        for (size_t i = 0; i < _params.size(); ++i) {
+          param_values[i] = _params[i] ? _params[i]->c_str() : nullptr;
+        }
+
+        return PostgresV2Result::make(
+                   PQexecPrepared(conn_.ptr(), _name.c_str(),
+                                  static_cast<int>(_params.size()),
+                                  param_values.data(), nullptr, nullptr, 0))
+            .and_then([&](auto&& _res) -> Result<Nothing> {
+              const auto status = PQresultStatus(_res.ptr());
+              if (status != PGRES_COMMAND_OK && status != PGRES_TUPLES_OK) {
+                invalidate_if_missing(_sql, _res.ptr());
+                return error(std::string("Query execution failed: ") +
+                             PQresultErrorMessage(_res.ptr()));
+              }
+              return Nothing{};
+            });
+      });
+}
+
+void Connection::abort_write(const std::string& _msg) noexcept {
+  binary_write_ = false;
+  copy_buffer_.clear();
+  PQputCopyEnd(conn_.ptr(), _msg.c_str());
+  while (PGresult* res = PQgetResult(conn_.ptr())) {
+    PQclear(res);
+  }
 }
 
 Result<Nothing> Connection::end_write() {
+  if (binary_write_) {
+    binary_write_ = false;
+    // The trailer of the binary format is a tuple with -1 fields.
+    parsing::append_as<int16_t>(-1, &copy_buffer_);
+  }
+  const auto res = flush_copy_buffer();
+  if (!res) {
+    return res;
+  }
   if (PQputCopyEnd(conn_.ptr(), NULL) == -1) {
     return error(PQerrorMessage(conn_.ptr()));
   }
@@ -53,6 +123,23 @@ Result<Nothing> Connection::end_write() {
       });
 }
 
+Result<Nothing> Connection::flush_copy_buffer() noexcept {
+  // PQputCopyData takes the size as an int, so very large buffers have to be
+  // sent in several parts.
+  constexpr size_t max_chunk_size = 1 << 30;
+  for (size_t pos = 0; pos < copy_buffer_.size(); pos += max_chunk_size) {
+    const auto size = std::min(copy_buffer_.size() - pos, max_chunk_size);
+    if (PQputCopyData(conn_.ptr(), copy_buffer_.data() + pos,
+                      static_cast<int>(size)) != 1) {
+      const std::string msg = PQerrorMessage(conn_.ptr());
+      abort_write(msg);
+      return error(msg);
+    }
+  }
+  copy_buffer_.clear();
+  return Nothing{};
+}
+
 std::list<Notification> Connection::get_notifications() noexcept {
   std::list<Notification> notices;
 
@@ -75,6 +162,39 @@ std::list<Notification> Connection::get_notifications() noexcept {
   return notices;
 }
 
+size_t Connection::get_notifications(
+    std::vector<Notification>* _notifications) noexcept {
+  if (!PQconsumeInput(conn_.ptr())) {
+    return 0;
+  }
+
+  size_t num_notifications = 0;
+  PGnotify* notify = nullptr;
+  while ((notify = PQnotifies(conn_.ptr())) != nullptr) {
+    _notifications->push_back({.channel = std::string(notify->relname),
+                               .payload = std::string(notify->extra),
+                               .backend_pid = notify->be_pid});
+    PQfreemem(notify);
+    ++num_notifications;
+  }
+
+  return num_notifications;
+}
+
+Result<Nothing> Connection::ping() noexcept {
+  if (PQstatus(conn_.ptr()) != CONNECTION_OK) {
+    return error(std::string("Connection to postgres is broken: ") +
+                 PQerrorMessage(conn_.ptr()));
+  }
+#ifdef LIBPQ_HAS_PIPELINING
+  if (PQpipelineStatus(conn_.ptr()) != PQ_PIPELINE_OFF) {
+    return error(
+        "Connection to postgres is broken: It is stuck in pipeline mode.");
+  }
+#endif
+  return execute("SELECT 1;");
+}
+
 rfl::Result<Nothing> Connection::listen(const std::string& channel) noexcept {
   if (!is_valid_channel_name(channel)) {
     return error("Invalid channel name: must be a PostgreSQL identifier");
@@ -126,103 +246,298 @@ Result<Nothing> Connection::insert_impl(
     return Nothing{};
   }
 
-  const auto name = "sqlgen_insert_into_table_" + internal::random();
-
   const auto sql = to_sql_impl(_stmt);
 
-  return PostgresV2Result::make(PQprepare(conn_.ptr(), name.c_str(),
-                                          sql.c_str(), _data.at(0).size(),
-                                          nullptr))
-      .and_then([&](auto&& res) -> Result<Nothing> {
-        const auto status = PQresultStatus(res.ptr());
+  return prepare(sql, _data.at(0).size()).and_then([&](const auto& _name) {
+    return insert_rows(sql, _name, _data);
+  });
+}
 
-        if (status != PGRES_COMMAND_OK) {
-          return error("Generating prepared statement for '" + sql +
-                       "' failed: " + PQresultErrorMessage(res.ptr()));
+void Connection::invalidate_if_missing(const std::string& _sql,
+                                       const PGresult* _res) noexcept {
+  // 26000 is invalid_sql_statement_name.
+  const char* sqlstate = PQresultErrorField(_res, PG_DIAG_SQLSTATE);
+  if (sqlstate && std::string_view(sqlstate) == "26000") {
+    prepared_statements_.invalidate(_sql);
+  }
+}
+
+#ifdef LIBPQ_HAS_PIPELINING
+Result<Nothing> Connection::flush_pipeline() noexcept {
+  while (true) {
+    const int res = PQflush(conn_.ptr());
+    if (res == 0) {
+      return Nothing{};
+    }
+    if (res < 0) {
+      return error(std::string("Sending the pipeline failed: ") +
+                   PQerrorMessage(conn_.ptr()));
+    }
+
+    // The server may have stopped reading our queries, because it is waiting
+    // for us to read its results. So we wait until the socket is either
+    // writable or readable and buffer whatever the server has sent.
+    pollfd fd = {};
+    fd.fd = PQsocket(conn_.ptr());
+    fd.events = POLLIN | POLLOUT;
+#ifdef _WIN32
+    const int n = WSAPoll(&fd, 1, -1);
+#else
+    const int n = poll(&fd, 1, -1);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+#endif
+    if (n < 0) {
+      return error("Waiting for the socket failed.");
+    }
+
+    if ((fd.revents & POLLIN) && PQconsumeInput(conn_.ptr()) != 1) {
+      return error(std::string("Reading the results failed: ") +
+                   PQerrorMessage(conn_.ptr()));
+    }
+  }
+}
+#endif
+
+Result<Nothing> Connection::insert_rows(
+    const std::string& _sql, const std::string& _name,
+    const std::vector<std::vector<std::optional<std::string>>>&
+        _data) noexcept {
+  const size_t n_params = _data.at(0).size();
+
+  for (size_t i = 0; i < _data.size(); ++i) {
+    if (_data[i].size() != n_params) {
+      return error("Error in entry " + std::to_string(i) + ": Expected " +
+                   std::to_string(n_params) + " entries, got " +
+                   std::to_string(_data[i].size()));
+    }
+  }
+
+  std::vector<const char*> current_row(n_params);
+
+  const auto set_current_row = [&](const size_t _i) {
+    for (size_t j = 0; j < n_params; ++j) {
+      current_row[j] = _data[_i][j] ? _data[_i][j]->c_str() : nullptr;
+    }
+  };
+
+#ifdef LIBPQ_HAS_PIPELINING
+  // The server sends the results while we are still sending rows. On a
+  // blocking socket, both sides could end up waiting for the other to read,
+  // so the rows are sent in nonblocking mode, see flush_pipeline().
+  if (PQsetnonblocking(conn_.ptr(), 1) != 0) {
+    return error(std::string("Switching to nonblocking mode failed: ") +
+                 PQerrorMessage(conn_.ptr()));
+  }
+
+  if (PQenterPipelineMode(conn_.ptr()) != 1) {
+    const auto err = error(std::string("Entering pipeline mode failed: ") +
+                           PQerrorMessage(conn_.ptr()));
+    PQsetnonblocking(conn_.ptr(), 0);
+    return err;
+  }
+
+  std::optional<std::string> err;
+
+  for (size_t begin = 0; begin < _data.size() && !err; begin += pipeline_depth) {
+    const auto end = std::min(begin + pipeline_depth, _data.size());
+
+    size_t num_sent = 0;
+    for (size_t i = begin; i < end; ++i, ++num_sent) {
+      set_current_row(i);
+      if (PQsendQueryPrepared(conn_.ptr(), _name.c_str(),
+                              static_cast<int>(n_params), current_row.data(),
+                              nullptr, nullptr, 0) != 1) {
+        err = PQerrorMessage(conn_.ptr());
+        break;
+      }
+    }
+
+    const bool synced = PQpipelineSync(conn_.ptr()) == 1;
+    if (!synced && !err) {
+      err = PQerrorMessage(conn_.ptr());
+    }
+
+    // Even without a sync, the queries that have been sent must be flushed
+    // and their results read, before we can leave pipeline mode.
+    const auto flushed = flush_pipeline();
+    if (!flushed) {
+      // The results of queries that never reached the server would never
+      // arrive, so we cannot drain them. Leaving pipeline mode fails below.
+      if (!err) {
+        err = flushed.error().what();
+      }
+      break;
+    }
+
+    // Every query returns its results followed by a nullptr. Once a query
+    // has failed, all following queries up to the sync are aborted.
+    for (size_t i = 0; i < num_sent; ++i) {
+      while (PGresult* res = PQgetResult(conn_.ptr())) {
+        if (PQresultStatus(res) == PGRES_FATAL_ERROR && !err) {
+          invalidate_if_missing(_sql, res);
+          err = PQresultErrorMessage(res);
         }
+        PQclear(res);
+      }
+    }
 
-        std::vector<const char*> current_row(_data[0].size());
-
-        const int n_params = static_cast<int>(current_row.size());
-
-        for (size_t i = 0; i < _data.size(); ++i) {
-          const auto& d = _data[i];
-
-          if (d.size() != current_row.size()) {
-            execute("DEALLOCATE " + name + ";");
-            return error("Error in entry " + std::to_string(i) + ": Expected " +
-                         std::to_string(current_row.size()) + " entries, got " +
-                         std::to_string(d.size()));
-          }
-
-          for (size_t j = 0; j < d.size(); ++j) {
-            current_row[j] = d[j] ? d[j]->c_str() : nullptr;
-          }
-
-          try {
-            const auto res = PostgresV2Result(PQexecPrepared(
-                conn_.ptr(),         // conn
-                name.c_str(),        // stmtName
-                n_params,            // nParams
-                current_row.data(),  // paramValues
-                nullptr,             // paramLengths
-                nullptr,             // paramFormats
-                0                    // resultFormat
-                ));
-
-            const auto status = PQresultStatus(res.ptr());
-
-            if (status != PGRES_COMMAND_OK) {
-              const auto err = error(std::string("Executing INSERT failed: ") +
-                                     PQresultErrorMessage(res.ptr()));
-              execute("DEALLOCATE " + name + ";");
-              return err;
-            }
-          } catch (const std::exception& e) {
-            const auto err =
-                error(std::string("Executing INSERT failed: ") + e.what());
-            execute("DEALLOCATE " + name + ";");
-            return err;
-          }
+    if (synced) {
+      PGresult* sync = PQgetResult(conn_.ptr());
+      if (!sync || PQresultStatus(sync) != PGRES_PIPELINE_SYNC) {
+        if (!err) {
+          err = PQerrorMessage(conn_.ptr());
         }
+      }
+      PQclear(sync);
+    }
+  }
 
-        return execute("DEALLOCATE " + name + ";");
-      });
+  // If we cannot leave pipeline mode, every statement executed on this
+  // connection from now on would fail. ping() reports it as broken, so that
+  // connection pools replace it.
+  if (PQexitPipelineMode(conn_.ptr()) != 1 ||
+      PQsetnonblocking(conn_.ptr(), 0) != 0) {
+    return error(
+        std::string("Leaving pipeline mode failed, the connection is "
+                    "broken: ") +
+        PQerrorMessage(conn_.ptr()) +
+        (err ? " Executing INSERT failed: " + *err : std::string()));
+  }
+
+  if (err) {
+    return error("Executing INSERT failed: " + *err);
+  }
+
+  return Nothing{};
+
+#else
+  for (size_t i = 0; i < _data.size(); ++i) {
+    set_current_row(i);
+
+    const auto res = PostgresV2Result::make(PQexecPrepared(
+        conn_.ptr(), _name.c_str(), static_cast<int>(n_params),
+        current_row.data(), nullptr, nullptr, 0));
+
+    if (!res) {
+      return error(std::string("Executing INSERT failed: ") +
+                   res.error().what());
+    }
+
+    if (PQresultStatus(res->ptr()) != PGRES_COMMAND_OK) {
+      invalidate_if_missing(_sql, res->ptr());
+      return error(std::string("Executing INSERT failed: ") +
+                   PQresultErrorMessage(res->ptr()));
+    }
+  }
+
+  return Nothing{};
+#endif
 }
 
 rfl::Result<Ref<Connection>> Connection::make(
     const Credentials& _credentials) noexcept {
   return PostgresV2Connection::make(_credentials.to_str(),
                                     _credentials.notice_handler)
-      .transform([](auto&& _conn) { return Ref<Connection>::make(_conn); });
+      .transform([&](auto&& _conn) {
+        return Ref<Connection>::make(_conn, _credentials);
+      });
+}
+
+Result<std::string> Connection::prepare(const std::string& _sql,
+                                        const size_t _num_params) noexcept {
+  if (prepared_statements_.enabled()) {
+    const auto name = prepared_statements_.find(_sql);
+    if (name) {
+      return *name;
+    }
+  }
+
+  // The unnamed statement is replaced whenever another one is prepared, so it
+  // never needs to be deallocated.
+  const auto name =
+      prepared_statements_.enabled() ? prepared_statements_.make_name() : "";
+
+  const auto res = PostgresV2Result::make(
+      PQprepare(conn_.ptr(), name.c_str(), _sql.c_str(),
+                static_cast<int>(_num_params), nullptr));
+
+  if (!res) {
+    return error(res.error().what());
+  }
+
+  if (PQresultStatus(res->ptr()) != PGRES_COMMAND_OK) {
+    return error("Generating prepared statement for '" + _sql +
+                 "' failed: " + PQresultErrorMessage(res->ptr()));
+  }
+
+  if (prepared_statements_.enabled()) {
+    const auto evicted = prepared_statements_.insert(_sql, name);
+    if (evicted) {
+      // If this fails, the statement just stays on the server until the
+      // connection is closed. Its name is never reused.
+      execute("DEALLOCATE " + *evicted + ";");
+    }
+  }
+
+  return name;
 }
 
 Result<Ref<Iterator>> Connection::read_impl(
-    const rfl::Variant<dynamic::SelectFrom, dynamic::Union>& _query) {
-  const auto sql = _query.visit([](const auto& _q) { return to_sql_impl(_q); });
-  return Iterator::make(sql, conn_);
+    const rfl::Variant<dynamic::SelectFrom, dynamic::Union>& _query,
+    const bool _stream) {
+  std::vector<dynamic::Value> values;
+  const auto sql =
+      _query.visit([&](const auto& _q) { return to_sql_impl(_q, &values); });
+  return Iterator::make(sql, conn_, to_params(values),
+                        IteratorOptions{.binary_results = binary_results_,
+                                        .fetch_size = fetch_size_,
+                                        .prefetch = prefetch_,
+                                        .use_cursor = !_stream});
 }
 
 Result<Nothing> Connection::rollback() noexcept { return execute("ROLLBACK;"); }
 
-std::string Connection::to_buffer(
-    const std::vector<std::optional<std::string>>& _line) const noexcept {
-  using namespace std::ranges::views;
-
-  const auto edit_field =
-      [](const std::optional<std::string>& _field) -> std::string {
-    if (!_field) {
-      return "\e";
-    }
-    if (_field->find("\t") != std::string::npos) {
-      return "\a" + *_field + "\a";
+std::optional<std::string> Connection::to_param(const dynamic::Value& _val) {
+  return _val.val.visit([](const auto& _v) -> std::optional<std::string> {
+    using Type = std::remove_cvref_t<decltype(_v)>;
+    if constexpr (std::is_same_v<Type, dynamic::Boolean>) {
+      return _v.val ? "true" : "false";
+
+    } else if constexpr (std::is_same_v<Type, dynamic::Float>) {
+      // std::to_string only keeps six decimal places.
+#ifdef __cpp_lib_to_chars
+      char buf[32];
+      const auto [ptr, ec] = std::to_chars(buf, buf + sizeof(buf), _v.val);
+      return std::string(buf, ptr);
+#else
+      std::ostringstream stream;
+      stream << std::setprecision(17) << _v.val;
+      return stream.str();
+#endif
+
+    } else if constexpr (std::is_same_v<Type, dynamic::Integer>) {
+      return std::to_string(_v.val);
+
+    } else if constexpr (std::is_same_v<Type, dynamic::String>) {
+      return _v.val;
+
+    } else {
+      // These are never bound by to_sql_impl.
+      return std::nullopt;
     }
-    return *_field;
-  };
+  });
+}
 
-  return internal::strings::join(
-             "\t", internal::collect::vector(_line | transform(edit_field))) +
-         "\n";
+std::vector<std::optional<std::string>> Connection::to_params(
+    const std::vector<dynamic::Value>& _values) {
+  std::vector<std::optional<std::string>> params;
+  params.reserve(_values.size());
+  for (const auto& val : _values) {
+    params.emplace_back(to_param(val));
+  }
+  return params;
 }
 
 std::string Connection::to_sql(const dynamic::Statement& _stmt) noexcept {
@@ -230,24 +545,21 @@ std::string Connection::to_sql(const dynamic::Statement& _stmt) noexcept {
 }
 
 Result<Nothing> Connection::start_write(const dynamic::Write& _stmt) {
-  return execute(postgres::to_sql_impl(_stmt));
-}
-
-Result<Nothing> Connection::write_impl(
-    const std::vector<std::vector<std::optional<std::string>>>& _data) {
-  for (const auto& line : _data) {
-    const auto buffer = to_buffer(line);
-    const auto success = PQputCopyData(conn_.ptr(), buffer.c_str(),
-                                       static_cast<int>(buffer.size()));
-    if (success != 1) {
-      PQputCopyEnd(conn_.ptr(), NULL);
-      return error("Error occurred while writing data to postgres.");
+  return execute(postgres::to_sql_impl(_stmt)).transform([&](auto&&) {
+    binary_write_ = _stmt.binary;
+    copy_buffer_.clear();
+    if (binary_write_) {
+      // The signature, followed by the flags and the length of the header
+      // extension, which are both 0.
+      copy_buffer_.assign("PGCOPY\n\377\r\n\0", 11);
+      parsing::append_as<int32_t>(0, &copy_buffer_);
+      parsing::append_as<int32_t>(0, &copy_buffer_);
     }
-  }
-  return Nothing{};
+    return Nothing{};
+  });
 }
 
-bool Connection::is_valid_channel_name(const std::string& s) const noexcept {
+bool Connection::is_valid_channel_name(const std::string& s) noexcept {
   if (s.empty()) return false;
   const char first = s[0];
   if (first != '_' && !std::isalpha(static_cast<unsigned char>(first)))
@@ -0,0 +1,157 @@
+#include "sqlgen/postgres/EventLoop.hpp"
+
+#ifdef __linux__
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace sqlgen::postgres {
+
+EventLoop::EventLoop()
+    : epoll_fd_(epoll_create1(EPOLL_CLOEXEC)),
+      wake_fd_(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)),
+      stop_(false) {
+  if (epoll_fd_ < 0 || wake_fd_ < 0) {
+    const auto msg = std::string("Could not create the event loop: ") +
+                     std::strerror(errno);
+    if (epoll_fd_ >= 0) {
+      close(epoll_fd_);
+    }
+    if (wake_fd_ >= 0) {
+      close(wake_fd_);
+    }
+    throw std::runtime_error(msg);
+  }
+
+  epoll_event ev{};
+  ev.events = EPOLLIN;
+  ev.data.fd = wake_fd_;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev) != 0) {
+    const auto msg = std::string("Could not create the event loop: ") +
+                     std::strerror(errno);
+    close(epoll_fd_);
+    close(wake_fd_);
+    throw std::runtime_error(msg);
+  }
+
+  thread_ = std::thread([this]() { run(); });
+}
+
+EventLoop::~EventLoop() {
+  stop_ = true;
+  wake_up();
+  thread_.join();
+  close(epoll_fd_);
+  close(wake_fd_);
+}
+
+Result<Nothing> EventLoop::add(const int _fd, const uint32_t _events,
+                               const Handler& _handler) noexcept {
+  epoll_event ev{};
+  ev.events = _events;
+  ev.data.fd = _fd;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, _fd, &ev) != 0) {
+    return error(std::string("Could not watch socket: ") +
+                 std::strerror(errno));
+  }
+  handlers_[_fd] = std::make_shared<Handler>(_handler);
+  return Nothing{};
+}
+
+Result<Ref<EventLoop>> EventLoop::make() noexcept {
+  try {
+    return Ref<EventLoop>::make();
+  } catch (const std::exception& e) {
+    return error(e.what());
+  }
+}
+
+Result<Nothing> EventLoop::modify(const int _fd,
+                                  const uint32_t _events) noexcept {
+  epoll_event ev{};
+  ev.events = _events;
+  ev.data.fd = _fd;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, _fd, &ev) != 0) {
+    return error(std::string("Could not watch socket: ") +
+                 std::strerror(errno));
+  }
+  return Nothing{};
+}
+
+void EventLoop::post(const Task& _task) {
+  {
+    std::lock_guard lock(mtx_);
+    tasks_.push_back(_task);
+  }
+  wake_up();
+}
+
+void EventLoop::remove(const int _fd) noexcept {
+  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, _fd, nullptr);
+  handlers_.erase(_fd);
+}
+
+void EventLoop::run() {
+  constexpr int max_events = 64;
+  epoll_event events[max_events];
+
+  while (!stop_) {
+    const int n = epoll_wait(epoll_fd_, events, max_events, -1);
+
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+
+    for (int i = 0; i < n && !stop_; ++i) {
+      const int fd = events[i].data.fd;
+
+      if (fd == wake_fd_) {
+        uint64_t count = 0;
+        while (read(wake_fd_, &count, sizeof(count)) > 0) {
+        }
+        run_tasks();
+        continue;
+      }
+
+      // Earlier handlers in this batch may have removed this one.
+      const auto it = handlers_.find(fd);
+      if (it == handlers_.end()) {
+        continue;
+      }
+      const auto handler = it->second;
+      (*handler)(events[i].events);
+    }
+  }
+}
+
+void EventLoop::run_tasks() {
+  std::vector<Task> tasks;
+  {
+    std::lock_guard lock(mtx_);
+    tasks.swap(tasks_);
+  }
+  for (const auto& task : tasks) {
+    if (stop_) {
+      return;
+    }
+    task();
+  }
+}
+
+void EventLoop::wake_up() noexcept {
+  const uint64_t one = 1;
+  [[maybe_unused]] const auto n = write(wake_fd_, &one, sizeof(one));
+}
+
+}  // namespace sqlgen::postgres
+
+#endif
@@ -3,24 +3,64 @@
 #include <ranges>
 #include <rfl.hpp>
 #include <sstream>
+#include <stdexcept>
 
+#include "sqlgen/internal/batch_size.hpp"
 #include "sqlgen/internal/collect/vector.hpp"
 #include "sqlgen/internal/strings/strings.hpp"
 #include "sqlgen/postgres/exec.hpp"
 
 namespace sqlgen::postgres {
 
-Iterator::Iterator(const std::string& _sql, const Conn& _conn)
-    : cursor_name_(make_cursor_name()), conn_(_conn), end_(false) {
-  exec(conn_, "BEGIN").value();
-  exec(conn_, "DECLARE " + cursor_name_ + " CURSOR FOR " + _sql).value();
+Iterator::Iterator(const std::string& _sql, const Conn& _conn,
+                   const std::vector<std::optional<std::string>>& _params,
+                   const IteratorOptions& _options)
+    : cursor_name_(make_cursor_name()),
+      conn_(_conn),
+      end_(false),
+      binary_results_(_options.binary_results),
+      fetch_size_(_options.fetch_size),
+      prefetch_(_options.prefetch),
+      prefetched_(false),
+      use_cursor_(_options.use_cursor),
+      own_transaction_(false),
+      stream_done_(false) {
+  // If the user has already begun a transaction, the read happens inside of
+  // it and we must neither end it nor make it fail.
+  own_transaction_ = PQtransactionStatus(conn_.ptr()) == PQTRANS_IDLE;
+
+  if (!use_cursor_) {
+    start_stream(_sql, _params);
+    return;
+  }
+
+  // A cursor can only live inside a transaction.
+  if (own_transaction_) {
+    exec(conn_, "BEGIN").value();
+  }
+  const auto declare = "DECLARE " + cursor_name_ + " CURSOR FOR " + _sql;
+  if (_params.empty()) {
+    exec(conn_, declare).value();
+  } else {
+    PostgresV2Result::make(declare, conn_, _params).value();
+  }
 }
 
 Iterator::Iterator(Iterator&& _other) noexcept
     : cursor_name_(std::move(_other.cursor_name_)),
       conn_(std::move(_other.conn_)),
-      end_(_other.end_) {
+      end_(_other.end_),
+      binary_results_(_other.binary_results_),
+      fetch_size_(_other.fetch_size_),
+      prefetch_(_other.prefetch_),
+      prefetched_(_other.prefetched_),
+      use_cursor_(_other.use_cursor_),
+      own_transaction_(_other.own_transaction_),
+      stream_done_(_other.stream_done_),
+      pending_(std::move(_other.pending_)) {
   _other.end_ = true;
+  _other.prefetched_ = false;
+  _other.pending_ = std::nullopt;
 }
 
 Iterator::~Iterator() { shutdown(); }
@@ -58,15 +98,25 @@ Result<std::vector<std::vector<std::optional<std::string>>>> Iterator::next(
     return vec;
   };
 
-  return exec(conn_, "FETCH FORWARD " + std::to_string(_batch_size) + " FROM " +
-                         cursor_name_ + ";")
-      .transform(to_vector)
-      .transform([this](auto&& _vec) {
-        if (_vec.size() == 0) {
-          shutdown();
-        }
-        return std::move(_vec);
-      });
+  // When streaming, the format was chosen when the query was sent.
+  if (!use_cursor_ && binary_results_) {
+    return error(
+        "Rows streamed in binary format cannot be read as strings.");
+  }
+
+  return fetch(_batch_size, 0).transform([&](auto&& _results) {
+    std::vector<std::vector<std::optional<std::string>>> vec;
+    vec.reserve(count_rows(_results));
+    for (const auto& res : _results) {
+      auto rows = to_vector(res);
+      vec.insert(vec.end(), std::make_move_iterator(rows.begin()),
+                 std::make_move_iterator(rows.end()));
+    }
+    if (vec.size() == 0) {
+      shutdown();
+    }
+    return vec;
+  });
 }
 
 Iterator& Iterator::operator=(Iterator&& _other) noexcept {
@@ -77,16 +127,232 @@ Iterator& Iterator::operator=(Iterator&& _other) noexcept {
   cursor_name_ = std::move(_other.cursor_name_);
   conn_ = std::move(_other.conn_);
   end_ = _other.end_;
+  binary_results_ = _other.binary_results_;
+  fetch_size_ = _other.fetch_size_;
+  prefetch_ = _other.prefetch_;
+  prefetched_ = _other.prefetched_;
+  use_cursor_ = _other.use_cursor_;
+  own_transaction_ = _other.own_transaction_;
+  stream_done_ = _other.stream_done_;
+  pending_ = std::move(_other.pending_);
   _other.end_ = true;
+  _other.prefetched_ = false;
+  _other.pending_ = std::nullopt;
   return *this;
 }
 
+size_t Iterator::count_rows(const std::vector<PostgresV2Result>& _results) {
+  size_t num_rows = 0;
+  for (const auto& res : _results) {
+    num_rows += static_cast<size_t>(PQntuples(res.ptr()));
+  }
+  return num_rows;
+}
+
+void Iterator::drain_stream() {
+  while (PGresult* r = PQgetResult(conn_.ptr())) {
+    PQclear(r);
+  }
+  pending_ = std::nullopt;
+  stream_done_ = true;
+}
+
+Result<std::vector<PostgresV2Result>> Iterator::fetch(
+    const size_t _batch_size, const int _result_format) {
+  if (!use_cursor_) {
+    return fetch_from_stream(fetch_size_ != 0 ? fetch_size_ : _batch_size);
+  }
+  return fetch_from_cursor(_batch_size, _result_format)
+      .transform([](auto&& _res) {
+        std::vector<PostgresV2Result> results;
+        results.emplace_back(std::move(_res));
+        return results;
+      });
+}
+
+Result<PostgresV2Result> Iterator::fetch_from_cursor(
+    const size_t _batch_size, const int _result_format) {
+  const auto batch_size = fetch_size_ != 0 ? fetch_size_ : _batch_size;
+
+  auto res = prefetched_ ? receive_prefetched()
+                         : PostgresV2Result::make(make_fetch_sql(batch_size),
+                                                  conn_, {}, _result_format);
+
+  // A batch that is not full is the last one, so there is nothing left to
+  // prefetch.
+  if (res && prefetch_ &&
+      static_cast<size_t>(PQntuples(res->ptr())) == batch_size) {
+    const auto sql = make_fetch_sql(batch_size);
+    prefetched_ = PQsendQueryParams(conn_.ptr(), sql.c_str(), 0, nullptr,
+                                    nullptr, nullptr, nullptr,
+                                    _result_format) == 1;
+  }
+
+  return res;
+}
+
+Result<std::vector<PostgresV2Result>> Iterator::fetch_from_stream(
+    const size_t _batch_size) {
+  std::vector<PostgresV2Result> results;
+  size_t num_rows = 0;
+
+  if (pending_) {
+    num_rows += static_cast<size_t>(PQntuples(pending_->ptr()));
+    results.emplace_back(std::move(*pending_));
+    pending_ = std::nullopt;
+  }
+
+  while (!stream_done_ && num_rows < _batch_size) {
+    auto res = receive_streamed();
+    if (!res) {
+      return error(res.error().what());
+    }
+    if (!*res) {
+      break;
+    }
+    num_rows += static_cast<size_t>(PQntuples((*res)->ptr()));
+    results.emplace_back(std::move(**res));
+  }
+
+  return results;
+}
+
+void Iterator::read_row(PGresult* _res, const int _i,
+                        std::vector<std::optional<std::string_view>>* _row) {
+  const int num_cols = static_cast<int>(_row->size());
+  for (int j = 0; j < num_cols; ++j) {
+    if (PQgetisnull(_res, _i, j)) {
+      (*_row)[j] = std::nullopt;
+    } else {
+      (*_row)[j] =
+          std::string_view(PQgetvalue(_res, _i, j), PQgetlength(_res, _i, j));
+    }
+  }
+}
+
+Result<PostgresV2Result> Iterator::receive_prefetched() {
+  prefetched_ = false;
+
+  // We have to consume all of the results, before the connection can be used
+  // again, but we only need the first one.
+  std::optional<Result<PostgresV2Result>> res;
+  while (PGresult* r = PQgetResult(conn_.ptr())) {
+    if (res) {
+      PQclear(r);
+      continue;
+    }
+    if (PQresultStatus(r) != PGRES_TUPLES_OK) {
+      res = error(std::string("Query execution failed: ") +
+                  PQresultErrorMessage(r));
+      PQclear(r);
+    } else {
+      res = PostgresV2Result(r);
+    }
+  }
+
+  if (!res) {
+    return error(std::string("Query execution failed: ") +
+                 PQerrorMessage(conn_.ptr()));
+  }
+
+  return std::move(*res);
+}
+
+Result<std::optional<PostgresV2Result>> Iterator::receive_streamed() {
+  while (PGresult* r = PQgetResult(conn_.ptr())) {
+    const auto status = PQresultStatus(r);
+    const bool has_rows = status == PGRES_SINGLE_TUPLE ||
+#ifdef LIBPQ_HAS_CHUNK_MODE
+                          status == PGRES_TUPLES_CHUNK ||
+#endif
+                          status == PGRES_TUPLES_OK;
+    if (!has_rows) {
+      const auto msg =
+          std::string("Query execution failed: ") + PQresultErrorMessage(r);
+      PQclear(r);
+      drain_stream();
+      return error(msg);
+    }
+
+    // The final PGRES_TUPLES_OK marks the end of the rows and is usually
+    // empty.
+    if (PQntuples(r) == 0) {
+      PQclear(r);
+      continue;
+    }
+
+    return std::optional<PostgresV2Result>(PostgresV2Result(r));
+  }
+
+  stream_done_ = true;
+  return std::optional<PostgresV2Result>();
+}
+
 void Iterator::shutdown() {
-  if (!end_) {
-    exec(conn_, "CLOSE " + cursor_name_);
+  if (prefetched_) {
+    receive_prefetched();
+  }
+  if (end_) {
+    return;
+  }
+  end_ = true;
+  if (!use_cursor_) {
+    // Rather than reading the rows that are left, we ask the server to stop
+    // sending them. The connection can only be used again once all of the
+    // results have been consumed. A cancelled statement aborts the
+    // transaction it runs in, so inside a transaction begun by the user, we
+    // read the rows that are left instead.
+    if (!stream_done_) {
+      if (own_transaction_) {
+        if (PGcancel* cancel = PQgetCancel(conn_.ptr())) {
+          char errbuf[256];
+          PQcancel(cancel, errbuf, sizeof(errbuf));
+          PQfreeCancel(cancel);
+        }
+      }
+      drain_stream();
+    }
+    return;
+  }
+  exec(conn_, "CLOSE " + cursor_name_);
+  if (own_transaction_) {
     exec(conn_, "END");
-    end_ = true;
   }
 }
 
+void Iterator::start_stream(
+    const std::string& _sql,
+    const std::vector<std::optional<std::string>>& _params) {
+  std::vector<const char*> param_values(_params.size());
+  for (size_t i = 0; i < _params.size(); ++i) {
+    param_values[i] = _params[i] ? _params[i]->c_str() : nullptr;
+  }
+
+  const int sent = PQsendQueryParams(
+      conn_.ptr(), _sql.c_str(), static_cast<int>(_params.size()), nullptr,
+      param_values.data(), nullptr, nullptr, binary_results_ ? 1 : 0);
+  if (!sent) {
+    throw std::runtime_error(std::string("Query execution failed: ") +
+                             PQerrorMessage(conn_.ptr()));
+  }
+
+  // Chunked mode hands over up to fetch_size rows per PGresult. It requires
+  // libpq 17, so older versions fall back to single row mode, which is
+  // slower, but still saves the round trips of a cursor.
+#ifdef LIBPQ_HAS_CHUNK_MODE
+  const auto chunk_size = fetch_size_ != 0 ? fetch_size_ : SQLGEN_BATCH_SIZE;
+  PQsetChunkedRowsMode(conn_.ptr(), static_cast<int>(chunk_size));
+#else
+  PQsetSingleRowMode(conn_.ptr());
+#endif
+
+  // We wait for the first rows, so that errors in the query are reported
+  // when the read is made, just like with a cursor.
+  auto first = receive_streamed();
+  if (!first) {
+    throw std::runtime_error(first.error().what());
+  }
+  pending_ = std::move(*first);
+}
+
 }  // namespace sqlgen::postgres
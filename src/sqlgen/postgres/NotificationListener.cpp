@@ -0,0 +1,188 @@
+#include "sqlgen/postgres/NotificationListener.hpp"
+
+#ifdef __linux__
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "sqlgen/postgres/exec.hpp"
+
+namespace sqlgen::postgres {
+
+namespace {
+
+std::string to_lower(std::string _str) {
+  std::transform(_str.begin(), _str.end(), _str.begin(), [](const char c) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  });
+  return _str;
+}
+
+}  // namespace
+
+NotificationListener::NotificationListener(const Conn& _conn)
+    : conn_(_conn),
+      socket_(PQsocket(_conn.ptr())),
+      epoll_fd_(epoll_create1(EPOLL_CLOEXEC)),
+      wake_fd_(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) {
+  const auto fail = [&](const std::string& _msg) {
+    if (epoll_fd_ >= 0) {
+      close(epoll_fd_);
+    }
+    if (wake_fd_ >= 0) {
+      close(wake_fd_);
+    }
+    throw std::runtime_error(_msg);
+  };
+
+  if (socket_ < 0) {
+    fail("The connection has no socket.");
+  }
+
+  if (epoll_fd_ < 0 || wake_fd_ < 0) {
+    fail(std::string("Could not create the notification listener: ") +
+         std::strerror(errno));
+  }
+
+  for (const int fd : {socket_, wake_fd_}) {
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) != 0) {
+      fail(std::string("Could not watch socket: ") + std::strerror(errno));
+    }
+  }
+}
+
+NotificationListener::~NotificationListener() {
+  close(epoll_fd_);
+  close(wake_fd_);
+}
+
+size_t NotificationListener::dispatch() {
+  size_t num_notifications = 0;
+  PGnotify* notify = nullptr;
+  while ((notify = PQnotifies(conn_.ptr())) != nullptr) {
+    const auto notification =
+        Notification{.channel = std::string(notify->relname),
+                     .payload = std::string(notify->extra),
+                     .backend_pid = notify->be_pid};
+    PQfreemem(notify);
+    ++num_notifications;
+
+    const auto it = callbacks_.find(notification.channel);
+    if (it == callbacks_.end()) {
+      continue;
+    }
+    for (const auto& callback : it->second) {
+      callback(notification);
+    }
+  }
+  return num_notifications;
+}
+
+Result<Nothing> NotificationListener::listen(
+    const std::string& _channel, const Callback& _callback) noexcept {
+  if (!Connection::is_valid_channel_name(_channel)) {
+    return error("Invalid channel name: must be a PostgreSQL identifier");
+  }
+
+  auto channel = to_lower(_channel);
+
+  const auto it = callbacks_.find(channel);
+  if (it != callbacks_.end()) {
+    it->second.push_back(_callback);
+    return Nothing{};
+  }
+
+  return exec(conn_, "LISTEN " + channel).transform([&](const auto&) {
+    callbacks_[std::move(channel)].push_back(_callback);
+    return Nothing{};
+  });
+}
+
+Result<Ref<NotificationListener>> NotificationListener::make(
+    const Credentials& _credentials) noexcept {
+  return PostgresV2Connection::make(_credentials.to_str(),
+                                    _credentials.notice_handler)
+      .and_then([](auto&& _conn) -> Result<Ref<NotificationListener>> {
+        try {
+          return Ref<NotificationListener>::make(_conn);
+        } catch (const std::exception& e) {
+          return error(e.what());
+        }
+      });
+}
+
+Result<Nothing> NotificationListener::unlisten(
+    const std::string& _channel) noexcept {
+  if (!Connection::is_valid_channel_name(_channel)) {
+    return error("Invalid channel name");
+  }
+
+  const auto channel = to_lower(_channel);
+
+  return exec(conn_, "UNLISTEN " + channel).transform([&](const auto&) {
+    callbacks_.erase(channel);
+    return Nothing{};
+  });
+}
+
+NotificationWaitResult NotificationListener::wait(
+    const std::chrono::milliseconds _timeout) {
+  // Notifications may have been read along with the results of LISTEN or
+  // UNLISTEN, in which case the socket will not signal them again.
+  if (dispatch() > 0) {
+    return NotificationWaitResult::Ready;
+  }
+
+  constexpr int max_events = 2;
+  epoll_event events[max_events];
+
+  const int n = epoll_wait(epoll_fd_, events, max_events,
+                           static_cast<int>(_timeout.count()));
+
+  if (n < 0) {
+    return errno == EINTR ? NotificationWaitResult::Timeout
+                          : NotificationWaitResult::Error;
+  }
+
+  if (n == 0) {
+    return NotificationWaitResult::Timeout;
+  }
+
+  for (int i = 0; i < n; ++i) {
+    if (events[i].data.fd == wake_fd_) {
+      uint64_t count = 0;
+      while (read(wake_fd_, &count, sizeof(count)) > 0) {
+      }
+      continue;
+    }
+
+    // A single read consumes everything the socket has buffered, so a burst
+    // of notifications is handled in one go.
+    if (!PQconsumeInput(conn_.ptr())) {
+      return NotificationWaitResult::Error;
+    }
+    dispatch();
+  }
+
+  return NotificationWaitResult::Ready;
+}
+
+void NotificationListener::wake_up() noexcept {
+  const uint64_t one = 1;
+  [[maybe_unused]] const auto n = write(wake_fd_, &one, sizeof(one));
+}
+
+}  // namespace sqlgen::postgres
+
+#endif
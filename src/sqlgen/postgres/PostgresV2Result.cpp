@@ -19,7 +19,8 @@ rfl::Result<PostgresV2Result> PostgresV2Result::make(
 
 rfl::Result<PostgresV2Result> PostgresV2Result::make(
     const std::string& _query, const PostgresV2Connection& _conn,
-    const std::vector<std::optional<std::string>>& _params) noexcept {
+    const std::vector<std::optional<std::string>>& _params,
+    const int _result_format) noexcept {
   std::vector<const char*> param_values(_params.size());
   for (size_t i = 0; i < _params.size(); ++i) {
     param_values[i] = _params[i] ? _params[i]->c_str() : nullptr;
@@ -31,7 +32,7 @@ rfl::Result<PostgresV2Result> PostgresV2Result::make(
                           param_values.data(), // paramValues
                           nullptr,             // paramLengths (text format)
                           nullptr,             // paramFormats (text format)
-                          0);                  // resultFormat (text)
+                          _result_format);     // resultFormat
 
   const auto status = PQresultStatus(res);
   if (status != PGRES_COMMAND_OK && status != PGRES_TUPLES_OK &&
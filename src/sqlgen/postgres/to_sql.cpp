@@ -18,10 +18,23 @@ std::string aggregation_to_sql(
 
 std::string column_or_value_to_sql(const dynamic::ColumnOrValue& _col) noexcept;
 
-std::string condition_to_sql(const dynamic::Condition& _cond) noexcept;
+std::string column_or_param_to_sql(
+    const dynamic::ColumnOrValue& _col,
+    std::vector<dynamic::Value>* _params) noexcept;
+
+std::string condition_to_sql(
+    const dynamic::Condition& _cond,
+    std::vector<dynamic::Value>* _params = nullptr) noexcept;
+
+std::string comparison_to_sql(const dynamic::Operation& _op1,
+                              const std::string& _comparison,
+                              const dynamic::Operation& _op2,
+                              std::vector<dynamic::Value>* _params) noexcept;
 
 template <class ConditionType>
-std::string condition_to_sql_impl(const ConditionType& _condition) noexcept;
+std::string condition_to_sql_impl(
+    const ConditionType& _condition,
+    std::vector<dynamic::Value>* _params) noexcept;
 
 std::string column_to_sql_definition(const dynamic::Column& _col) noexcept;
 
@@ -31,7 +44,9 @@ std::string create_table_to_sql(const dynamic::CreateTable& _stmt) noexcept;
 
 std::string create_as_to_sql(const dynamic::CreateAs& _stmt) noexcept;
 
-std::string delete_from_to_sql(const dynamic::DeleteFrom& _stmt) noexcept;
+std::string delete_from_to_sql(
+    const dynamic::DeleteFrom& _stmt,
+    std::vector<dynamic::Value>* _params = nullptr) noexcept;
 
 std::string drop_to_sql(const dynamic::Drop& _stmt) noexcept;
 
@@ -47,23 +62,37 @@ std::vector<std::pair<std::string, std::vector<std::string>>> get_enum_types(
 
 std::string insert_to_sql(const dynamic::Insert& _stmt) noexcept;
 
-std::string join_to_sql(const dynamic::Join& _stmt) noexcept;
+bool is_value(const dynamic::Operation& _op) noexcept;
+
+std::string join_to_sql(
+    const dynamic::Join& _stmt,
+    std::vector<dynamic::Value>* _params = nullptr) noexcept;
+
+std::string operand_to_sql(const dynamic::Operation& _op,
+                           std::vector<dynamic::Value>* _params) noexcept;
 
 std::string operation_to_sql(const dynamic::Operation& _stmt) noexcept;
 
 std::string properties_to_sql(
     const dynamic::types::Properties& _properties) noexcept;
 
-std::string select_from_to_sql(const dynamic::SelectFrom& _stmt) noexcept;
+std::string select_from_to_sql(
+    const dynamic::SelectFrom& _stmt,
+    std::vector<dynamic::Value>* _params = nullptr) noexcept;
 
 std::string table_or_query_to_sql(
-    const dynamic::SelectFrom::TableOrQueryType& _table_or_query) noexcept;
+    const dynamic::SelectFrom::TableOrQueryType& _table_or_query,
+    std::vector<dynamic::Value>* _params = nullptr) noexcept;
 
 std::string type_to_sql(const dynamic::Type& _type) noexcept;
 
-std::string union_to_sql(const dynamic::Union& _stmt) noexcept;
+std::string union_to_sql(
+    const dynamic::Union& _stmt,
+    std::vector<dynamic::Value>* _params = nullptr) noexcept;
 
-std::string update_to_sql(const dynamic::Update& _stmt) noexcept;
+std::string update_to_sql(
+    const dynamic::Update& _stmt,
+    std::vector<dynamic::Value>* _params = nullptr) noexcept;
 
 std::string write_to_sql(const dynamic::Write& _stmt) noexcept;
 
@@ -162,13 +191,61 @@ std::string column_or_value_to_sql(
   });
 }
 
-std::string condition_to_sql(const dynamic::Condition& _cond) noexcept {
+std::string column_or_param_to_sql(
+    const dynamic::ColumnOrValue& _col,
+    std::vector<dynamic::Value>* _params) noexcept {
+  if (!_params) {
+    return column_or_value_to_sql(_col);
+  }
+
+  return _col.visit([&](const auto& _c) -> std::string {
+    using Type = std::remove_cvref_t<decltype(_c)>;
+    if constexpr (std::is_same_v<Type, dynamic::Value>) {
+      const bool is_bindable = _c.val.visit([](const auto& _v) {
+        using V = std::remove_cvref_t<decltype(_v)>;
+        return std::is_same_v<V, dynamic::Boolean> ||
+               std::is_same_v<V, dynamic::Float> ||
+               std::is_same_v<V, dynamic::Integer> ||
+               std::is_same_v<V, dynamic::String>;
+      });
+      if (is_bindable) {
+        _params->push_back(_c);
+        // The type of an untyped placeholder is inferred from the other
+        // operand, so a fraction compared to or assigned to an integer column
+        // would fail to parse as an integer.
+        const bool is_float = _c.val.visit([](const auto& _v) {
+          return std::is_same_v<std::remove_cvref_t<decltype(_v)>,
+                                dynamic::Float>;
+        });
+        return "$" + std::to_string(_params->size()) +
+               (is_float ? "::double precision" : "");
+      }
+    }
+    return column_or_value_to_sql(_c);
+  });
+}
+
+std::string condition_to_sql(const dynamic::Condition& _cond,
+                             std::vector<dynamic::Value>* _params) noexcept {
   return _cond.val.visit(
-      [&](const auto& _c) { return condition_to_sql_impl(_c); });
+      [&](const auto& _c) { return condition_to_sql_impl(_c, _params); });
+}
+
+std::string comparison_to_sql(const dynamic::Operation& _op1,
+                              const std::string& _comparison,
+                              const dynamic::Operation& _op2,
+                              std::vector<dynamic::Value>* _params) noexcept {
+  // Two placeholders would be compared as text, so values compared to each
+  // other stay inline.
+  auto* params = is_value(_op1) && is_value(_op2) ? nullptr : _params;
+  return operand_to_sql(_op1, params) + _comparison +
+         operand_to_sql(_op2, params);
 }
 
 template <class ConditionType>
-std::string condition_to_sql_impl(const ConditionType& _condition) noexcept {
+std::string condition_to_sql_impl(
+    const ConditionType& _condition,
+    std::vector<dynamic::Value>* _params) noexcept {
   using namespace std::ranges::views;
 
   using C = std::remove_cvref_t<ConditionType>;
@@ -176,31 +253,33 @@ std::string condition_to_sql_impl(const ConditionType& _condition) noexcept {
   std::stringstream stream;
 
   if constexpr (std::is_same_v<C, dynamic::Condition::And>) {
-    stream << "(" << condition_to_sql(*_condition.cond1) << ") AND ("
-           << condition_to_sql(*_condition.cond2) << ")";
+    stream << "(" << condition_to_sql(*_condition.cond1, _params) << ") AND ("
+           << condition_to_sql(*_condition.cond2, _params) << ")";
 
   } else if constexpr (std::is_same_v<
                            C, dynamic::Condition::BooleanColumnOrValue>) {
     stream << column_or_value_to_sql(_condition.col_or_val);
 
   } else if constexpr (std::is_same_v<C, dynamic::Condition::Equal>) {
-    stream << operation_to_sql(_condition.op1) << " = "
-           << operation_to_sql(_condition.op2);
+    stream << comparison_to_sql(_condition.op1, " = ", _condition.op2,
+                                _params);
 
   } else if constexpr (std::is_same_v<C, dynamic::Condition::GreaterEqual>) {
-    stream << operation_to_sql(_condition.op1)
-           << " >= " << operation_to_sql(_condition.op2);
+    stream << comparison_to_sql(_condition.op1, " >= ", _condition.op2,
+                                _params);
 
   } else if constexpr (std::is_same_v<C, dynamic::Condition::GreaterThan>) {
-    stream << operation_to_sql(_condition.op1) << " > "
-           << operation_to_sql(_condition.op2);
+    stream << comparison_to_sql(_condition.op1, " > ", _condition.op2,
+                                _params);
 
   } else if constexpr (std::is_same_v<C, dynamic::Condition::In>) {
     stream << operation_to_sql(_condition.op) << " IN ("
            << internal::strings::join(
                   ", ",
-                  internal::collect::vector(_condition.patterns |
-                                            transform(column_or_value_to_sql)))
+                  internal::collect::vector(
+                      _condition.patterns | transform([&](const auto& _p) {
+                        return column_or_param_to_sql(_p, _params);
+                      })))
            << ")";
 
   } else if constexpr (std::is_same_v<C, dynamic::Condition::IsNull>) {
@@ -210,39 +289,41 @@ std::string condition_to_sql_impl(const ConditionType& _condition) noexcept {
     stream << operation_to_sql(_condition.op) << " IS NOT NULL";
 
   } else if constexpr (std::is_same_v<C, dynamic::Condition::LesserEqual>) {
-    stream << operation_to_sql(_condition.op1)
-           << " <= " << operation_to_sql(_condition.op2);
+    stream << comparison_to_sql(_condition.op1, " <= ", _condition.op2,
+                                _params);
 
   } else if constexpr (std::is_same_v<C, dynamic::Condition::LesserThan>) {
-    stream << operation_to_sql(_condition.op1) << " < "
-           << operation_to_sql(_condition.op2);
+    stream << comparison_to_sql(_condition.op1, " < ", _condition.op2,
+                                _params);
 
   } else if constexpr (std::is_same_v<C, dynamic::Condition::Like>) {
     stream << operation_to_sql(_condition.op) << " LIKE "
-           << column_or_value_to_sql(_condition.pattern);
+           << column_or_param_to_sql(_condition.pattern, _params);
 
   } else if constexpr (std::is_same_v<C, dynamic::Condition::Not>) {
-    stream << "NOT (" << condition_to_sql(*_condition.cond) << ")";
+    stream << "NOT (" << condition_to_sql(*_condition.cond, _params) << ")";
 
   } else if constexpr (std::is_same_v<C, dynamic::Condition::NotEqual>) {
-    stream << operation_to_sql(_condition.op1)
-           << " != " << operation_to_sql(_condition.op2);
+    stream << comparison_to_sql(_condition.op1, " != ", _condition.op2,
+                                _params);
 
   } else if constexpr (std::is_same_v<C, dynamic::Condition::NotLike>) {
     stream << operation_to_sql(_condition.op) << " NOT LIKE "
-           << column_or_value_to_sql(_condition.pattern);
+           << column_or_param_to_sql(_condition.pattern, _params);
 
   } else if constexpr (std::is_same_v<C, dynamic::Condition::NotIn>) {
     stream << operation_to_sql(_condition.op) << " NOT IN ("
            << internal::strings::join(
                   ", ",
-                  internal::collect::vector(_condition.patterns |
-                                            transform(column_or_value_to_sql)))
+                  internal::collect::vector(
+                      _condition.patterns | transform([&](const auto& _p) {
+                        return column_or_param_to_sql(_p, _params);
+                      })))
            << ")";
 
   } else if constexpr (std::is_same_v<C, dynamic::Condition::Or>) {
-    stream << "(" << condition_to_sql(*_condition.cond1) << ") OR ("
-           << condition_to_sql(*_condition.cond2) << ")";
+    stream << "(" << condition_to_sql(*_condition.cond1, _params) << ") OR ("
+           << condition_to_sql(*_condition.cond2, _params) << ")";
 
   } else {
     static_assert(rfl::always_false_v<C>, "Not all cases were covered.");
@@ -373,7 +454,8 @@ std::string create_as_to_sql(const dynamic::CreateAs& _stmt) noexcept {
   return stream.str();
 }
 
-std::string delete_from_to_sql(const dynamic::DeleteFrom& _stmt) noexcept {
+std::string delete_from_to_sql(const dynamic::DeleteFrom& _stmt,
+                               std::vector<dynamic::Value>* _params) noexcept {
   std::stringstream stream;
 
   stream << "DELETE FROM ";
@@ -384,7 +466,7 @@ std::string delete_from_to_sql(const dynamic::DeleteFrom& _stmt) noexcept {
   stream << wrap_in_quotes(_stmt.table.name);
 
   if (_stmt.where) {
-    stream << " WHERE " << condition_to_sql(*_stmt.where);
+    stream << " WHERE " << condition_to_sql(*_stmt.where, _params);
   }
 
   stream << ";";
@@ -510,16 +592,23 @@ std::string insert_to_sql(const dynamic::Insert& _stmt) noexcept {
   return stream.str();
 }
 
-std::string join_to_sql(const dynamic::Join& _stmt) noexcept {
+bool is_value(const dynamic::Operation& _op) noexcept {
+  return _op.val.visit([](const auto& _o) {
+    return std::is_same_v<std::remove_cvref_t<decltype(_o)>, dynamic::Value>;
+  });
+}
+
+std::string join_to_sql(const dynamic::Join& _stmt,
+                        std::vector<dynamic::Value>* _params) noexcept {
   std::stringstream stream;
 
   stream << internal::strings::to_upper(internal::strings::replace_all(
                 rfl::enum_to_string(_stmt.how), "_", " "))
-         << " " << table_or_query_to_sql(_stmt.table_or_query) << " "
+         << " " << table_or_query_to_sql(_stmt.table_or_query, _params) << " "
          << _stmt.alias << " ";
 
   if (_stmt.on) {
-    stream << "ON " << condition_to_sql(*_stmt.on);
+    stream << "ON " << condition_to_sql(*_stmt.on, _params);
   } else {
     stream << "ON 1 = 1";
   }
@@ -527,6 +616,18 @@ std::string join_to_sql(const dynamic::Join& _stmt) noexcept {
   return stream.str();
 }
 
+std::string operand_to_sql(const dynamic::Operation& _op,
+                           std::vector<dynamic::Value>* _params) noexcept {
+  return _op.val.visit([&](const auto& _o) -> std::string {
+    using Type = std::remove_cvref_t<decltype(_o)>;
+    if constexpr (std::is_same_v<Type, dynamic::Value>) {
+      return column_or_param_to_sql(_o, _params);
+    } else {
+      return operation_to_sql(_op);
+    }
+  });
+}
+
 std::string operation_to_sql(const dynamic::Operation& _stmt) noexcept {
   using namespace std::ranges::views;
   return _stmt.val.visit([](const auto& _s) -> std::string {
@@ -706,7 +807,8 @@ std::string properties_to_sql(const dynamic::types::Properties& _p) noexcept {
   }();
 }
 
-std::string select_from_to_sql(const dynamic::SelectFrom& _stmt) noexcept {
+std::string select_from_to_sql(const dynamic::SelectFrom& _stmt,
+                               std::vector<dynamic::Value>* _params) noexcept {
   using namespace std::ranges::views;
 
   const auto order_by_to_str = [](const auto& _w) -> std::string {
@@ -719,7 +821,7 @@ std::string select_from_to_sql(const dynamic::SelectFrom& _stmt) noexcept {
   stream << internal::strings::join(
       ", ", internal::collect::vector(_stmt.fields | transform(field_to_str)));
 
-  stream << " FROM " << table_or_query_to_sql(_stmt.table_or_query);
+  stream << " FROM " << table_or_query_to_sql(_stmt.table_or_query, _params);
 
   if (_stmt.alias) {
     stream << " " << *_stmt.alias;
@@ -728,12 +830,14 @@ std::string select_from_to_sql(const dynamic::SelectFrom& _stmt) noexcept {
   if (_stmt.joins) {
     stream << " "
            << internal::strings::join(
-                  " ", internal::collect::vector(*_stmt.joins |
-                                                 transform(join_to_sql)));
+                  " ", internal::collect::vector(
+                         *_stmt.joins | transform([&](const auto& _join) {
+                           return join_to_sql(_join, _params);
+                         })));
   }
 
   if (_stmt.where) {
-    stream << " WHERE " << condition_to_sql(*_stmt.where);
+    stream << " WHERE " << condition_to_sql(*_stmt.where, _params);
   }
 
   if (_stmt.group_by) {
@@ -763,8 +867,9 @@ std::string select_from_to_sql(const dynamic::SelectFrom& _stmt) noexcept {
 }
 
 std::string table_or_query_to_sql(
-    const dynamic::SelectFrom::TableOrQueryType& _table_or_query) noexcept {
-  return _table_or_query.visit([](const auto& _t) -> std::string {
+    const dynamic::SelectFrom::TableOrQueryType& _table_or_query,
+    std::vector<dynamic::Value>* _params) noexcept {
+  return _table_or_query.visit([&](const auto& _t) -> std::string {
     using Type = std::remove_cvref_t<decltype(_t)>;
     if constexpr (std::is_same_v<Type, dynamic::Table>) {
       if (_t.schema) {
@@ -773,15 +878,20 @@ std::string table_or_query_to_sql(
       return wrap_in_quotes(_t.name);
 
     } else if constexpr (std::is_same_v<Type, Ref<dynamic::Union>>) {
-      return "(" + union_to_sql(*_t) + ")";
+      return "(" + union_to_sql(*_t, _params) + ")";
 
     } else {
-      return "(" + select_from_to_sql(*_t) + ")";
+      return "(" + select_from_to_sql(*_t, _params) + ")";
     }
   });
 }
 
 std::string to_sql_impl(const dynamic::Statement& _stmt) noexcept {
+  return to_sql_impl(_stmt, nullptr);
+}
+
+std::string to_sql_impl(const dynamic::Statement& _stmt,
+                        std::vector<dynamic::Value>* _params) noexcept {
   return _stmt.visit([&](const auto& _s) -> std::string {
     using S = std::remove_cvref_t<decltype(_s)>;
 
@@ -795,7 +905,7 @@ std::string to_sql_impl(const dynamic::Statement& _stmt) noexcept {
       return create_as_to_sql(_s);
 
     } else if constexpr (std::is_same_v<S, dynamic::DeleteFrom>) {
-      return delete_from_to_sql(_s);
+      return delete_from_to_sql(_s, _params);
 
     } else if constexpr (std::is_same_v<S, dynamic::Drop>) {
       return drop_to_sql(_s);
@@ -804,16 +914,16 @@ std::string to_sql_impl(const dynamic::Statement& _stmt) noexcept {
       return insert_to_sql(_s);
 
     } else if constexpr (std::is_same_v<S, dynamic::SelectFrom>) {
-      return select_from_to_sql(_s);
+      return select_from_to_sql(_s, _params);
 
     } else if constexpr (std::is_same_v<S, dynamic::Update>) {
-      return update_to_sql(_s);
+      return update_to_sql(_s, _params);
 
     } else if constexpr (std::is_same_v<S, dynamic::Write>) {
       return write_to_sql(_s);
 
     } else if constexpr (std::is_same_v<S, dynamic::Union>) {
-      return union_to_sql(_s);
+      return union_to_sql(_s, _params);
 
     } else {
       static_assert(rfl::always_false_v<S>, "Unsupported type.");
@@ -821,7 +931,8 @@ std::string to_sql_impl(const dynamic::Statement& _stmt) noexcept {
   });
 }
 
-std::string union_to_sql(const dynamic::Union& _stmt) noexcept {
+std::string union_to_sql(const dynamic::Union& _stmt,
+                         std::vector<dynamic::Value>* _params) noexcept {
   using namespace std::ranges::views;
 
   const auto columns = internal::strings::join(
@@ -829,7 +940,8 @@ std::string union_to_sql(const dynamic::Union& _stmt) noexcept {
       internal::collect::vector(_stmt.columns | transform(wrap_in_quotes)));
 
   const auto to_str = [&](const auto& _select) {
-    return "SELECT " + columns + " FROM (" + select_from_to_sql(_select) + ")";
+    return "SELECT " + columns + " FROM (" +
+           select_from_to_sql(_select, _params) + ")";
   };
 
   const auto separator =
@@ -893,12 +1005,13 @@ std::string type_to_sql(const dynamic::Type& _type) noexcept {
   });
 }
 
-std::string update_to_sql(const dynamic::Update& _stmt) noexcept {
+std::string update_to_sql(const dynamic::Update& _stmt,
+                          std::vector<dynamic::Value>* _params) noexcept {
   using namespace std::ranges::views;
 
-  const auto to_str = [](const auto& _set) -> std::string {
+  const auto to_str = [&](const auto& _set) -> std::string {
     return wrap_in_quotes(_set.col.name) + " = " +
-           column_or_value_to_sql(_set.to);
+           column_or_param_to_sql(_set.to, _params);
   };
 
   std::stringstream stream;
@@ -916,7 +1029,7 @@ std::string update_to_sql(const dynamic::Update& _stmt) noexcept {
       ", ", internal::collect::vector(_stmt.sets | transform(to_str)));
 
   if (_stmt.where) {
-    stream << " WHERE " << condition_to_sql(*_stmt.where);
+    stream << " WHERE " << condition_to_sql(*_stmt.where, _params);
   }
 
   stream << ";";
@@ -931,6 +1044,10 @@ std::string write_to_sql(const dynamic::Write& _stmt) noexcept {
   const auto colnames = internal::strings::join(
       ", ",
       internal::collect::vector(_stmt.columns | transform(wrap_in_quotes)));
+  if (_stmt.binary) {
+    return "COPY " + schema + "." + table + "(" + colnames +
+           ") FROM STDIN (FORMAT binary);";
+  }
   return "COPY " + schema + "." + table + "(" + colnames +
          ") FROM STDIN WITH DELIMITER '\t' NULL '\e' CSV QUOTE '\a';";
 }
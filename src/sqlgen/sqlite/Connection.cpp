@@ -1,5 +1,6 @@
 #include "sqlgen/sqlite/Connection.hpp"
 
+#include <algorithm>
 #include <ranges>
 #include <rfl.hpp>
 #include <rfl/Variant.hpp>
@@ -11,49 +12,96 @@
 
 namespace sqlgen::sqlite {
 
-Connection::Connection(const std::string& _fname)
-    : stmt_(nullptr), conn_(make_conn(_fname)) {}
+Connection::Connection(const std::string& _fname,
+                       const size_t _max_prepared_statements)
+    : Connection(Config{.fname = _fname,
+                        .max_prepared_statements = _max_prepared_statements}) {
+}
+
+Connection::Connection(const Config& _config)
+    : conn_(make_conn(_config)),
+      prepared_statements_(_config.max_prepared_statements) {}
 
 Connection::~Connection() = default;
 
 Result<Nothing> Connection::actual_insert(
-    const std::vector<std::vector<std::optional<std::string>>>& _data,
-    sqlite3_stmt* _stmt) const noexcept {
-  for (const auto& row : _data) {
-    const auto num_cols = static_cast<int>(row.size());
-
-    for (int i = 0; i < num_cols; ++i) {
-      if (row[i]) {
-        const auto res =
-            sqlite3_bind_text(_stmt, i + 1, row[i]->c_str(),
-                              static_cast<int>(row[i]->size()), SQLITE_STATIC);
-        if (res != SQLITE_OK) {
-          return error(sqlite3_errmsg(conn_.get()));
-        }
-      } else {
-        const auto res = sqlite3_bind_null(_stmt, i + 1);
-        if (res != SQLITE_OK) {
-          return error(sqlite3_errmsg(conn_.get()));
-        }
-      }
+    const std::variant<dynamic::Insert, dynamic::Write>& _stmt,
+    const std::vector<std::vector<std::optional<std::string>>>&
+        _data) noexcept {
+  const auto make_sql = [&](const size_t _num_rows) {
+    return std::visit(
+        [&](auto _s) {
+          _s.num_rows = _num_rows;
+          return to_sql_impl(_s);
+        },
+        _stmt);
+  };
+
+  const auto num_cols =
+      std::visit([](const auto& _s) { return _s.columns.size(); }, _stmt);
+
+  const auto max_rows = max_rows_per_insert(num_cols);
+
+  const auto num_full = _data.size() / max_rows;
+
+  if (num_full != 0) {
+    const auto res =
+        prepare_statement(make_sql(max_rows))
+            .and_then([&](auto&& _p_stmt) -> Result<Nothing> {
+              for (size_t i = 0; i < num_full; ++i) {
+                const auto inserted =
+                    insert_rows(_data, i * max_rows, max_rows, _p_stmt.get());
+                if (!inserted) {
+                  return inserted;
+                }
+              }
+              return Nothing{};
+            });
+    if (!res) {
+      return res;
     }
+  }
 
-    auto res = sqlite3_step(_stmt);
-    if (res != SQLITE_OK && res != SQLITE_ROW && res != SQLITE_DONE) {
-      return error(sqlite3_errmsg(conn_.get()));
-    }
+  const auto num_remaining = _data.size() % max_rows;
 
-    res = sqlite3_reset(_stmt);
+  if (num_remaining == 0) {
+    return Nothing{};
+  }
+
+  return prepare_statement(make_sql(num_remaining))
+      .and_then([&](auto&& _p_stmt) {
+        return insert_rows(_data, num_full * max_rows, num_remaining,
+                           _p_stmt.get());
+      });
+}
+
+Result<Nothing> Connection::bind_params(
+    const std::vector<dynamic::Value>& _params,
+    sqlite3_stmt* _stmt) const noexcept {
+  for (size_t i = 0; i < _params.size(); ++i) {
+    const int ix = static_cast<int>(i + 1);
+    const auto res = _params[i].val.visit([&](const auto& _v) -> int {
+      using Type = std::remove_cvref_t<decltype(_v)>;
+      if constexpr (std::is_same_v<Type, dynamic::Boolean>) {
+        return sqlite3_bind_int(_stmt, ix, _v.val ? 1 : 0);
+      } else if constexpr (std::is_same_v<Type, dynamic::Float>) {
+        return sqlite3_bind_double(_stmt, ix, _v.val);
+      } else if constexpr (std::is_same_v<Type, dynamic::Integer>) {
+        return sqlite3_bind_int64(_stmt, ix, _v.val);
+      } else if constexpr (std::is_same_v<Type, dynamic::String>) {
+        // The statement may outlive _params, so sqlite needs its own copy.
+        return sqlite3_bind_text(_stmt, ix, _v.val.c_str(),
+                                 static_cast<int>(_v.val.size()),
+                                 SQLITE_TRANSIENT);
+      } else {
+        // These are never bound by to_sql_impl.
+        return sqlite3_bind_null(_stmt, ix);
+      }
+    });
     if (res != SQLITE_OK) {
       return error(sqlite3_errmsg(conn_.get()));
     }
   }
-
-  const auto res = sqlite3_clear_bindings(_stmt);
-  if (res != SQLITE_OK) {
-    return error(sqlite3_errmsg(conn_.get()));
-  }
-
   return Nothing{};
 }
 
@@ -64,9 +112,17 @@ Result<Nothing> Connection::begin_transaction() noexcept {
 Result<Nothing> Connection::commit() noexcept { return execute("COMMIT;"); }
 
 rfl::Result<Ref<Connection>> Connection::make(
-    const std::string& _fname) noexcept {
+    const std::string& _fname, const size_t _max_prepared_statements) noexcept {
+  try {
+    return Ref<Connection>::make(_fname, _max_prepared_statements);
+  } catch (std::exception& e) {
+    return error(e.what());
+  }
+}
+
+rfl::Result<Ref<Connection>> Connection::make(const Config& _config) noexcept {
   try {
-    return Ref<Connection>::make(_fname);
+    return Ref<Connection>::make(_config);
   } catch (std::exception& e) {
     return error(e.what());
   }
@@ -83,48 +139,169 @@ Result<Nothing> Connection::execute(const std::string& _sql) noexcept {
   return Nothing{};
 }
 
+Result<Nothing> Connection::execute_statement(
+    const dynamic::Statement& _stmt) noexcept {
+  std::vector<dynamic::Value> params;
+  const auto sql = to_sql_impl(_stmt, &params);
+  return prepare_statement(sql).and_then(
+      [&](auto _p_stmt) -> Result<Nothing> {
+        return bind_params(params, _p_stmt.get())
+            .and_then([&](const auto&) -> Result<Nothing> {
+              const auto res = sqlite3_step(_p_stmt.get());
+
+              // The statement is kept for later, so it must not hold on to
+              // any locks.
+              sqlite3_reset(_p_stmt.get());
+
+              if (res != SQLITE_ROW && res != SQLITE_DONE) {
+                return error("Executing '" + sql +
+                             "' failed: " + sqlite3_errmsg(conn_.get()));
+              }
+              return Nothing{};
+            });
+      });
+}
+
 Result<Nothing> Connection::insert_impl(
     const dynamic::Insert& _stmt,
     const std::vector<std::vector<std::optional<std::string>>>&
         _data) noexcept {
-  const auto sql = to_sql_impl(_stmt);
-  return prepare_statement(sql).and_then(
-      [&](auto _p_stmt) { return actual_insert(_data, _p_stmt.get()); });
+  return actual_insert(_stmt, _data);
 }
 
-typename Connection::ConnPtr Connection::make_conn(const std::string& _fname) {
-  sqlite3* conn = nullptr;
-  const auto err = sqlite3_open(_fname.c_str(), &conn);
-  if (err) {
-    throw std::runtime_error("Can't open database: " +
-                             std::string(sqlite3_errmsg(conn)));
+Result<Nothing> Connection::insert_rows(
+    const std::vector<std::vector<std::optional<std::string>>>& _data,
+    const size_t _begin, const size_t _num_rows,
+    sqlite3_stmt* _stmt) const noexcept {
+  int ix = 1;
+
+  for (size_t i = _begin; i < _begin + _num_rows; ++i) {
+    for (const auto& field : _data[i]) {
+      const auto res =
+          field ? sqlite3_bind_text(_stmt, ix, field->c_str(),
+                                    static_cast<int>(field->size()),
+                                    SQLITE_STATIC)
+                : sqlite3_bind_null(_stmt, ix);
+      if (res != SQLITE_OK) {
+        return error(sqlite3_errmsg(conn_.get()));
+      }
+      ++ix;
+    }
   }
-  return ConnPtr::make(std::shared_ptr<sqlite3>(conn, &sqlite3_close)).value();
-}
 
-Result<Ref<Iterator>> Connection::read_impl(
-    const rfl::Variant<dynamic::SelectFrom, dynamic::Union>& _query) {
-  const auto sql = _query.visit([](const auto& _q) { return to_sql_impl(_q); });
+  if (ix - 1 != sqlite3_bind_parameter_count(_stmt)) {
+    return error("Expected " +
+                 std::to_string(sqlite3_bind_parameter_count(_stmt)) +
+                 " fields, got " + std::to_string(ix - 1) + ".");
+  }
 
-  sqlite3_stmt* p_stmt = nullptr;
+  auto res = sqlite3_step(_stmt);
+  if (res != SQLITE_OK && res != SQLITE_ROW && res != SQLITE_DONE) {
+    return error(sqlite3_errmsg(conn_.get()));
+  }
 
-  sqlite3_prepare_v2(conn_.get(), /* Database handle */
-                     sql.c_str(), /* SQL statement, UTF-8 encoded */
-                     sql.size(),  /* Maximum length of zSql in bytes. */
-                     &p_stmt,     /* OUT: Statement handle */
-                     nullptr      /* OUT: Pointer to unused portion of zSql */
-  );
+  res = sqlite3_reset(_stmt);
+  if (res != SQLITE_OK) {
+    return error(sqlite3_errmsg(conn_.get()));
+  }
 
-  if (!p_stmt) {
+  res = sqlite3_clear_bindings(_stmt);
+  if (res != SQLITE_OK) {
     return error(sqlite3_errmsg(conn_.get()));
   }
 
-  return Ref<sqlite3_stmt>::make(StmtPtr(p_stmt, &sqlite3_finalize))
-      .transform([&](auto _stmt) { return Ref<Iterator>::make(_stmt, conn_); });
+  return Nothing{};
+}
+
+typename Connection::ConnPtr Connection::make_conn(const Config& _config) {
+  sqlite3* p_conn = nullptr;
+  const auto err =
+      sqlite3_open_v2(_config.fname.c_str(), &p_conn, _config.flags, nullptr);
+
+  // Unlike sqlite3_close, sqlite3_close_v2 waits for the statements still
+  // held by iterators or the cache to be finalized, so the order in which
+  // they are destroyed does not matter. Even if opening the database fails,
+  // there is a handle that needs to be closed.
+  const auto conn = std::shared_ptr<sqlite3>(p_conn, &sqlite3_close_v2);
+
+  if (err) {
+    throw std::runtime_error(
+        "Can't open database: " +
+        std::string(p_conn ? sqlite3_errmsg(p_conn) : sqlite3_errstr(err)));
+  }
+
+  if (_config.busy_timeout) {
+    sqlite3_busy_timeout(conn.get(), *_config.busy_timeout);
+  }
+
+  const auto pragma = [&](const std::string& _name, const std::string& _value) {
+    const auto sql = "PRAGMA " + _name + " = " + _value + ";";
+    char* errmsg = nullptr;
+    sqlite3_exec(conn.get(), sql.c_str(), nullptr, nullptr, &errmsg);
+    if (errmsg) {
+      const auto msg = std::string(errmsg);
+      sqlite3_free(errmsg);
+      throw std::runtime_error("Setting '" + sql + "' failed: " + msg);
+    }
+  };
+
+  // The journal mode comes first, because the other settings may depend on
+  // it.
+  if (_config.journal_mode) {
+    pragma("journal_mode", _config.journal_mode->name());
+  }
+
+  if (_config.synchronous) {
+    pragma("synchronous", _config.synchronous->name());
+  }
+
+  if (_config.cache_size) {
+    pragma("cache_size", std::to_string(*_config.cache_size));
+  }
+
+  if (_config.mmap_size) {
+    pragma("mmap_size", std::to_string(*_config.mmap_size));
+  }
+
+  if (_config.temp_store) {
+    pragma("temp_store", _config.temp_store->name());
+  }
+
+  return ConnPtr::make(conn).value();
+}
+
+size_t Connection::max_rows_per_insert(const size_t _num_cols) const noexcept {
+  const auto max_params = static_cast<size_t>(
+      sqlite3_limit(conn_.get(), SQLITE_LIMIT_VARIABLE_NUMBER, -1));
+  return std::max<size_t>(
+      std::min<size_t>(max_params / std::max<size_t>(_num_cols, 1),
+                       SQLGEN_ROWS_PER_INSERT),
+      1);
+}
+
+Result<Ref<Iterator>> Connection::read_impl(
+    const rfl::Variant<dynamic::SelectFrom, dynamic::Union>& _query) {
+  std::vector<dynamic::Value> params;
+  const auto sql =
+      _query.visit([&](const auto& _q) { return to_sql_impl(_q, &params); });
+
+  return prepare_statement(sql)
+      .and_then([](auto&& _stmt) { return Ref<sqlite3_stmt>::make(_stmt); })
+      .and_then([&](auto _stmt) {
+        return bind_params(params, _stmt.get()).transform([&](const auto&) {
+          return Ref<Iterator>::make(_stmt, conn_);
+        });
+      });
 }
 
 Result<Connection::StmtPtr> Connection::prepare_statement(
-    const std::string& _sql) const noexcept {
+    const std::string& _sql) noexcept {
+  if (prepared_statements_.enabled()) {
+    if (auto stmt = prepared_statements_.find(_sql)) {
+      return std::move(*stmt);
+    }
+  }
+
   sqlite3_stmt* p_stmt = nullptr;
 
   sqlite3_prepare_v2(conn_.get(),  /* Database handle */
@@ -139,7 +316,13 @@ Result<Connection::StmtPtr> Connection::prepare_statement(
                  " Reason: " + sqlite3_errmsg(conn_.get()));
   }
 
-  return StmtPtr(p_stmt, &sqlite3_finalize);
+  auto stmt = StmtPtr(p_stmt, &sqlite3_finalize);
+
+  if (prepared_statements_.enabled()) {
+    prepared_statements_.insert(_sql, stmt);
+  }
+
+  return stmt;
 }
 
 Result<Nothing> Connection::rollback() noexcept { return execute("ROLLBACK;"); }
@@ -149,17 +332,17 @@ std::string Connection::to_sql(const dynamic::Statement& _stmt) noexcept {
 }
 
 Result<Nothing> Connection::start_write(const dynamic::Write& _stmt) {
-  if (stmt_) {
+  if (write_) {
     return error(
         "A write operation has already been launched. You need to call "
         ".end_write() before you can start another.");
   }
 
-  const auto sql = to_sql_impl(_stmt);
-
-  return prepare_statement(sql)
-      .transform([&](auto&& _stmt) {
-        stmt_ = std::move(_stmt);
+  // The statements are prepared once we know how many rows there are, but
+  // we want to know right away, if the statement is invalid.
+  return prepare_statement(to_sql_impl(_stmt))
+      .transform([&](auto&&) {
+        write_ = _stmt;
         return Nothing{};
       })
       .and_then([&](const auto&) { return begin_transaction(); });
@@ -167,13 +350,13 @@ Result<Nothing> Connection::start_write(const dynamic::Write& _stmt) {
 
 Result<Nothing> Connection::write_impl(
     const std::vector<std::vector<std::optional<std::string>>>& _data) {
-  if (!stmt_) {
+  if (!write_) {
     return error(
         " You need to call .start_write(...) before you can call "
         ".write(...).");
   }
 
-  return actual_insert(_data, stmt_.get())
+  return actual_insert(*write_, _data)
       .or_else([&](const auto& err) -> Result<Nothing> {
         rollback();
         return error(err.what());
@@ -181,12 +364,12 @@ Result<Nothing> Connection::write_impl(
 }
 
 Result<Nothing> Connection::end_write() {
-  if (!stmt_) {
+  if (!write_) {
     return error(
         " You need to call .start_write(...) before you can call "
         ".end_write().");
   }
-  stmt_ = nullptr;
+  write_ = std::nullopt;
   return commit().or_else([&](const auto& err) -> Result<Nothing> {
     rollback();
     return error(err.what());
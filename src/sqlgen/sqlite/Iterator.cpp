@@ -19,7 +19,11 @@ Iterator::Iterator(const StmtPtr& _stmt, const ConnPtr& _conn)
   step();
 }
 
-Iterator::~Iterator() = default;
+Iterator::~Iterator() {
+  // The statement may be kept by the connection for later use. Resetting it
+  // releases the locks it holds, if we have not reached the end.
+  sqlite3_reset(stmt_.get());
+}
 
 bool Iterator::end() const { return end_; }
 
@@ -38,7 +42,8 @@ Result<std::vector<std::vector<std::optional<std::string>>>> Iterator::next(
       auto ptr = sqlite3_column_text(stmt_.get(), j);
       if (ptr) {
         new_row.emplace_back(
-            std::string(std::launder(reinterpret_cast<const char*>(ptr))));
+            std::string(std::launder(reinterpret_cast<const char*>(ptr)),
+                        sqlite3_column_bytes(stmt_.get(), j)));
       } else {
         new_row.emplace_back(std::nullopt);
       }
@@ -1,5 +1,8 @@
+#include "sqlgen/postgres/AsyncConnection.cpp"
 #include "sqlgen/postgres/Connection.cpp"
+#include "sqlgen/postgres/EventLoop.cpp"
 #include "sqlgen/postgres/Iterator.cpp"
+#include "sqlgen/postgres/NotificationListener.cpp"
 #include "sqlgen/postgres/PostgresV2Connection.cpp"
 #include "sqlgen/postgres/PostgresV2Result.cpp"
 #include "sqlgen/postgres/exec.cpp"
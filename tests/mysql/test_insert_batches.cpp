@@ -0,0 +1,61 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/mysql.hpp>
+#include <vector>
+#include "test_helpers.hpp"
+
+namespace test_insert_batches {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  std::optional<int> age;
+};
+
+TEST(mysql, test_insert_batches) {
+  // Not a multiple of the number of rows per statement, so there is a
+  // remainder.
+  auto people1 = std::vector<Person>();
+  for (uint32_t i = 0; i < 1234; ++i) {
+    people1.emplace_back(
+        Person{.id = i,
+               .first_name = "Person " + std::to_string(i),
+               .last_name = "Simpson",
+               .age = i % 3 == 0 ? std::nullopt : std::make_optional<int>(i)});
+  }
+
+  const auto credentials = sqlgen::mysql::test::make_credentials();
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn = sqlgen::mysql::connect(credentials)
+                        .and_then(drop<Person> | if_exists)
+                        .and_then(create_table<Person> | if_not_exists)
+                        .and_then(insert(std::ref(people1)))
+                        .value();
+
+  const auto people2 =
+      (sqlgen::read<std::vector<Person>> | order_by("id"_c))(conn).value();
+
+  EXPECT_EQ(rfl::json::write(people2), rfl::json::write(people1));
+
+  const auto people3 = drop<Person>(conn)
+                           .and_then(write(std::ref(people1)))
+                           .and_then(sqlgen::read<std::vector<Person>> |
+                                     order_by("id"_c))
+                           .value();
+
+  EXPECT_EQ(rfl::json::write(people3), rfl::json::write(people1));
+}
+
+}  // namespace test_insert_batches
+
+#endif
@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+
+#include <sqlgen.hpp>
+#include <sqlgen/dynamic/Insert.hpp>
+#include <sqlgen/mysql.hpp>
+#include <sqlgen/transpilation/to_insert_or_write.hpp>
+
+namespace test_insert_batches_dry {
+
+struct TestTable {
+  std::string field1;
+  int32_t field2;
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::optional<std::string> nullable;
+};
+
+TEST(mysql, test_insert_batches_dry) {
+  auto insert_stmt =
+      sqlgen::transpilation::to_insert_or_write<TestTable,
+                                                sqlgen::dynamic::Insert>();
+  insert_stmt.num_rows = 2;
+
+  const auto expected =
+      R"(INSERT INTO `TestTable` (`field1`, `field2`, `id`, `nullable`) VALUES (?, ?, ?, ?), (?, ?, ?, ?);)";
+
+  EXPECT_EQ(sqlgen::mysql::to_sql(sqlgen::dynamic::Statement(insert_stmt)),
+            expected);
+}
+}  // namespace test_insert_batches_dry
@@ -0,0 +1,88 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+#ifdef __linux__
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/postgres.hpp>
+#include <vector>
+#include "test_helpers.hpp"
+
+namespace test_async {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+TEST(postgres, test_async) {
+  const auto people1 = std::vector<Person>(
+      {Person{
+           .id = 0, .first_name = "Homer", .last_name = "Simpson", .age = 45},
+       Person{.id = 1, .first_name = "Bart", .last_name = "Simpson", .age = 10},
+       Person{.id = 2, .first_name = "Lisa", .last_name = "Simpson", .age = 8},
+       Person{
+           .id = 3, .first_name = "Maggie", .last_name = "Simpson", .age = 0}});
+
+  const auto credentials = sqlgen::postgres::test::make_credentials();
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  sqlgen::postgres::connect(credentials)
+      .and_then(drop<Person> | if_exists)
+      .and_then(create_table<Person> | if_not_exists)
+      .value();
+
+  const auto loop = sqlgen::postgres::EventLoop::make().value();
+
+  // Two connections driven by the same event loop.
+  const auto conn1 = sqlgen::postgres::connect_async(credentials, loop).value();
+  const auto conn2 = sqlgen::postgres::connect_async(credentials, loop).value();
+
+  insert(conn1, people1).get().value();
+
+  auto children = (sqlgen::read<std::vector<Person>> |
+                   where("age"_c < 18) | order_by("age"_c))(conn1);
+
+  auto homer = (sqlgen::read<std::vector<Person>> |
+                where("first_name"_c == "Homer"))(conn2);
+
+  EXPECT_EQ(children.get().value().size(), 3);
+  EXPECT_EQ(homer.get().value().at(0).age, 45);
+
+  (update<Person>("age"_c.set(46)) | where("first_name"_c == "Homer"))(conn1)
+      .get()
+      .value();
+
+  (delete_from<Person> | where("first_name"_c == "Maggie"))(conn2)
+      .get()
+      .value();
+
+  const auto people2 =
+      (sqlgen::read<std::vector<Person>> | order_by("id"_c))(conn1)
+          .get()
+          .value();
+
+  const std::string expected =
+      R"([{"id":0,"first_name":"Homer","last_name":"Simpson","age":46},{"id":1,"first_name":"Bart","last_name":"Simpson","age":10},{"id":2,"first_name":"Lisa","last_name":"Simpson","age":8}])";
+
+  EXPECT_EQ(rfl::json::write(people2), expected);
+
+  // Errors are reported through the future and do not affect the queries
+  // after them.
+  auto fail = exec(conn1, "SELECT * FROM table_that_does_not_exist");
+  auto ok = exec(conn1, "SELECT 1");
+  EXPECT_FALSE(fail.get());
+  EXPECT_TRUE(ok.get());
+}
+
+}  // namespace test_async
+
+#endif
+#endif
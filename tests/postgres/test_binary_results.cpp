@@ -0,0 +1,90 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/postgres.hpp>
+#include <vector>
+
+#include "test_helpers.hpp"
+
+namespace test_binary_results {
+
+enum class Role { parent, child };
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  int16_t age;
+  int64_t savings;
+  double height;
+  float weight;
+  bool is_adult;
+  Role role;
+  std::optional<std::string> nickname;
+  sqlgen::Timestamp<"%Y-%m-%d %H:%M:%S"> ts;
+  sqlgen::Date birthday;
+};
+
+TEST(postgres, test_binary_results) {
+  const auto people1 = std::vector<Person>(
+      {Person{.id = 0,
+              .first_name = "Homer",
+              .age = 45,
+              .savings = -1234567890123,
+              .height = 1.83,
+              .weight = 108.5f,
+              .is_adult = true,
+              .role = Role::parent,
+              .nickname = std::nullopt,
+              .ts = "1999-12-31 23:59:59",
+              .birthday = "1956-05-12"},
+       Person{.id = 1,
+              .first_name = "Bart",
+              .age = 10,
+              .savings = 42,
+              .height = 1.2,
+              .weight = 31.25f,
+              .is_adult = false,
+              .role = Role::child,
+              .nickname = "El Barto",
+              .ts = "2000-01-01 01:00:00",
+              .birthday = "1980-04-01"}});
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  auto credentials = sqlgen::postgres::test::make_credentials();
+  credentials.binary_results = true;
+
+  const auto conn =
+      sqlgen::postgres::connect(credentials).and_then(drop<Person> | if_exists);
+
+  const auto people2 = sqlgen::write(conn, people1)
+                           .and_then(sqlgen::read<std::vector<Person>> |
+                                     order_by("id"_c))
+                           .value();
+
+  EXPECT_EQ(rfl::json::write(people1), rfl::json::write(people2));
+
+  struct Totals {
+    int64_t num_people;
+    double total_savings;
+  };
+
+  const auto totals =
+      sqlgen::select_from<Person>(count().as<"num_people">(),
+                                  sum("savings"_c).as<"total_savings">()) |
+      to<Totals>;
+
+  const auto result = totals(conn).value();
+
+  EXPECT_EQ(result.num_people, 2);
+  EXPECT_EQ(result.total_savings, -1234567890081.0);
+}
+
+}  // namespace test_binary_results
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+
+#include <gtest/gtest.h>
+
+#include <sqlgen.hpp>
+#include <sqlgen/postgres.hpp>
+
+#include "test_helpers.hpp"
+
+namespace test_connection_pool_health_check {
+
+TEST(postgres, test_connection_pool_health_check) {
+  const auto pool_config = sqlgen::ConnectionPoolConfig{
+      .size = 1, .health_check_on_acquire = true};
+
+  const auto credentials = sqlgen::postgres::test::make_credentials();
+
+  auto pool = sqlgen::make_connection_pool<sqlgen::postgres::Connection>(
+                  pool_config, credentials)
+                  .value();
+
+  // Simulates the server dropping the connection.
+  pool.acquire().value()->execute(
+      "SELECT pg_terminate_backend(pg_backend_pid());");
+
+  const auto res = pool.acquire().value()->execute("SELECT 1;");
+
+  EXPECT_TRUE(res && true);
+  EXPECT_EQ(pool.stats().num_recycled, 1);
+  EXPECT_EQ(pool.size(), 1);
+  EXPECT_EQ(pool.available(), 1);
+}
+
+}  // namespace test_connection_pool_health_check
+
+#endif
@@ -0,0 +1,41 @@
+#ifdef __linux__
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <sqlgen/postgres.hpp>
+#include <thread>
+
+namespace test_event_loop_dry {
+
+TEST(postgres, test_event_loop_dry) {
+  const auto loop = sqlgen::postgres::EventLoop::make().value();
+
+  EXPECT_FALSE(loop->in_loop_thread());
+
+  std::atomic<int> count = 0;
+  std::promise<bool> in_loop_thread;
+
+  // Tasks posted from several threads all run on the thread of the loop.
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&]() {
+      for (int j = 0; j < 100; ++j) {
+        loop->post([&]() { ++count; });
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  loop->post([&]() { in_loop_thread.set_value(loop->in_loop_thread()); });
+
+  EXPECT_TRUE(in_loop_thread.get_future().get());
+  EXPECT_EQ(count.load(), 400);
+}
+
+}  // namespace test_event_loop_dry
+
+#endif
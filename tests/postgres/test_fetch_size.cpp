@@ -0,0 +1,119 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/postgres.hpp>
+#include <vector>
+#include "test_helpers.hpp"
+
+namespace test_fetch_size {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+TEST(postgres, test_fetch_size) {
+  auto people1 = std::vector<Person>();
+  for (uint32_t i = 0; i < 1000; ++i) {
+    people1.emplace_back(Person{.id = i,
+                                .first_name = "Person " + std::to_string(i),
+                                .last_name = "Simpson",
+                                .age = static_cast<int>(i % 90)});
+  }
+
+  auto credentials = sqlgen::postgres::test::make_credentials();
+  credentials.fetch_size = 100;
+  credentials.prefetch = true;
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn = sqlgen::postgres::connect(credentials)
+                        .and_then(drop<Person> | if_exists)
+                        .and_then(create_table<Person> | if_not_exists)
+                        .and_then(insert(std::ref(people1)))
+                        .value();
+
+  const auto json1 = rfl::json::write(people1);
+
+  // The number of rows is a multiple of the fetch size, so the last batch
+  // that is prefetched is empty.
+  const auto people2 =
+      (sqlgen::read<std::vector<Person>> | order_by("id"_c))(conn).value();
+
+  EXPECT_EQ(rfl::json::write(people2), json1);
+
+  // The batches do not fit the number of rows.
+  conn->set_fetch_size(7);
+
+  const auto range =
+      (sqlgen::read<sqlgen::Range<Person>> | order_by("id"_c))(conn).value();
+
+  auto people3 = std::vector<Person>();
+  for (const auto& person : range) {
+    people3.emplace_back(person.value());
+  }
+
+  EXPECT_EQ(rfl::json::write(people3), json1);
+
+  // Prefetching can be switched on and off between reads.
+  conn->set_prefetch(false);
+
+  const auto people4 =
+      (sqlgen::read<std::vector<Person>> | where("age"_c == 0) |
+       order_by("id"_c))(conn)
+          .value();
+
+  EXPECT_EQ(people4.size(), 12);
+}
+
+TEST(postgres, test_fetch_size_abandon_range) {
+  auto people1 = std::vector<Person>();
+  for (uint32_t i = 0; i < 100; ++i) {
+    people1.emplace_back(Person{.id = i,
+                                .first_name = "Person " + std::to_string(i),
+                                .last_name = "Simpson",
+                                .age = static_cast<int>(i)});
+  }
+
+  auto credentials = sqlgen::postgres::test::make_credentials();
+  credentials.fetch_size = 10;
+  credentials.prefetch = true;
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn = sqlgen::postgres::connect(credentials)
+                        .and_then(drop<Person> | if_exists)
+                        .and_then(create_table<Person> | if_not_exists)
+                        .and_then(insert(std::ref(people1)))
+                        .value();
+
+  {
+    const auto range =
+        (sqlgen::read<sqlgen::Range<Person>> | order_by("id"_c))(conn)
+            .value();
+
+    // Only look at the first batch. The next one is in flight when the
+    // range is destroyed.
+    size_t count = 0;
+    for (auto it = range.begin(); it != range.end() && count < 10; ++it) {
+      ++count;
+    }
+    EXPECT_EQ(count, 10);
+  }
+
+  const auto people2 = sqlgen::read<std::vector<Person>>(conn).value();
+
+  EXPECT_EQ(people2.size(), 100);
+}
+
+}  // namespace test_fetch_size
+
+#endif
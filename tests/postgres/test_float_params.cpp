@@ -0,0 +1,75 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/postgres.hpp>
+#include <vector>
+#include "test_helpers.hpp"
+
+namespace test_float_params {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+TEST(postgres, test_float_params) {
+  const auto people1 = std::vector<Person>(
+      {Person{
+           .id = 0, .first_name = "Homer", .last_name = "Simpson", .age = 45},
+       Person{.id = 1, .first_name = "Bart", .last_name = "Simpson", .age = 10},
+       Person{.id = 2, .first_name = "Lisa", .last_name = "Simpson", .age = 8},
+       Person{
+           .id = 3, .first_name = "Maggie", .last_name = "Simpson", .age = 0}});
+
+  const auto credentials = sqlgen::postgres::test::make_credentials();
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn = sqlgen::postgres::connect(credentials)
+                        .and_then(drop<Person> | if_exists)
+                        .and_then(create_table<Person> | if_not_exists)
+                        .value();
+
+  insert(conn, people1).value();
+
+  // The fractional literals are bound as parameters, which must not be
+  // parsed as integers, because they are compared to an integer column.
+  const auto older =
+      (sqlgen::read<std::vector<Person>> | where("age"_c > 9.5) |
+       order_by("id"_c))(conn)
+          .value();
+
+  EXPECT_EQ(older.size(), 2);
+  EXPECT_EQ(older.at(0).first_name, "Homer");
+  EXPECT_EQ(older.at(1).first_name, "Bart");
+
+  const auto doubled =
+      (sqlgen::read<std::vector<Person>> | where("age"_c * 2 > 16.5) |
+       order_by("id"_c))(conn)
+          .value();
+
+  EXPECT_EQ(doubled.size(), 2);
+
+  // The fraction is rounded when it is assigned to the integer column.
+  (update<Person>("age"_c.set(0.6)) | where("first_name"_c == "Maggie"))(conn)
+      .value();
+
+  const auto people2 =
+      (sqlgen::read<std::vector<Person>> | order_by("id"_c))(conn).value();
+
+  const std::string expected =
+      R"([{"id":0,"first_name":"Homer","last_name":"Simpson","age":45},{"id":1,"first_name":"Bart","last_name":"Simpson","age":10},{"id":2,"first_name":"Lisa","last_name":"Simpson","age":8},{"id":3,"first_name":"Maggie","last_name":"Simpson","age":1}])";
+
+  EXPECT_EQ(rfl::json::write(people2), expected);
+}
+
+}  // namespace test_float_params
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/postgres.hpp>
+#include <vector>
+#include "test_helpers.hpp"
+
+namespace test_insert_many {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  std::optional<int> age;
+};
+
+TEST(postgres, test_insert_many) {
+  // More rows than are sent in a single pipeline segment.
+  auto people1 = std::vector<Person>();
+  for (uint32_t i = 0; i < 2500; ++i) {
+    people1.emplace_back(Person{
+        .id = i,
+        .first_name = "Person " + std::to_string(i),
+        .last_name = "Simpson",
+        .age = i % 7 == 0 ? std::optional<int>() : static_cast<int>(i % 90)});
+  }
+
+  const auto credentials = sqlgen::postgres::test::make_credentials();
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto people2 = sqlgen::postgres::connect(credentials)
+                           .and_then(drop<Person> | if_exists)
+                           .and_then(begin_transaction)
+                           .and_then(create_table<Person> | if_not_exists)
+                           .and_then(insert(std::ref(people1)))
+                           .and_then(commit)
+                           .and_then(sqlgen::read<std::vector<Person>> |
+                                     order_by("id"_c))
+                           .value();
+
+  const auto json1 = rfl::json::write(people1);
+  const auto json2 = rfl::json::write(people2);
+
+  EXPECT_EQ(json1, json2);
+}
+
+TEST(postgres, test_insert_many_fail) {
+  auto people1 = std::vector<Person>();
+  for (uint32_t i = 0; i < 2500; ++i) {
+    people1.emplace_back(Person{.id = i % 2000,
+                                .first_name = "Person " + std::to_string(i),
+                                .last_name = "Simpson",
+                                .age = 0});
+  }
+
+  const auto credentials = sqlgen::postgres::test::make_credentials();
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn = sqlgen::postgres::connect(credentials)
+                        .and_then(drop<Person> | if_exists)
+                        .and_then(create_table<Person> | if_not_exists);
+
+  const auto res = conn.and_then(begin_transaction)
+                       .and_then(insert(std::ref(people1)))
+                       .and_then(commit);
+
+  // Should fail - duplicate key violation in the last segment.
+  EXPECT_FALSE(res && true);
+
+  // The transaction has been rolled back, so none of the rows are written.
+  const auto people2 = conn.and_then(sqlgen::read<std::vector<Person>>).value();
+
+  EXPECT_EQ(people2.size(), 0);
+}
+
+}  // namespace test_insert_many
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+#ifdef __linux__
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <sqlgen/postgres.hpp>
+#include <string>
+#include <vector>
+#include "test_helpers.hpp"
+
+namespace test_notification_listener {
+
+TEST(postgres, test_notification_listener) {
+  using namespace sqlgen::postgres;
+
+  const auto credentials = sqlgen::postgres::test::make_credentials();
+
+  const auto listener = NotificationListener::make(credentials).value();
+  const auto sender = sqlgen::postgres::connect(credentials).value();
+
+  std::vector<std::string> payloads;
+  size_t num_other = 0;
+
+  listener
+      ->listen("listener_channel",
+               [&](const Notification& _n) { payloads.push_back(_n.payload); })
+      .value();
+
+  // Channel names are case-insensitive.
+  listener->listen("Other_Channel", [&](const Notification&) { ++num_other; })
+      .value();
+
+  // Nothing has been sent yet.
+  EXPECT_EQ(listener->wait(std::chrono::milliseconds(10)),
+            NotificationWaitResult::Timeout);
+
+  const size_t num_notifications = 1000;
+  for (size_t i = 0; i < num_notifications; ++i) {
+    sender->notify("listener_channel", "msg_" + std::to_string(i)).value();
+  }
+  sender->notify("other_channel").value();
+
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while ((payloads.size() < num_notifications || num_other == 0) &&
+         std::chrono::steady_clock::now() < deadline) {
+    ASSERT_NE(listener->wait(std::chrono::milliseconds(100)),
+              NotificationWaitResult::Error);
+  }
+
+  ASSERT_EQ(payloads.size(), num_notifications);
+  EXPECT_EQ(payloads.front(), "msg_0");
+  EXPECT_EQ(payloads.back(), "msg_999");
+  EXPECT_EQ(num_other, 1);
+
+  // Notifications on channels we no longer listen to are not dispatched.
+  listener->unlisten("listener_channel").value();
+  sender->notify("listener_channel", "ignored").value();
+  listener->wait(std::chrono::milliseconds(100));
+  EXPECT_EQ(payloads.size(), num_notifications);
+
+  // Waking the listener up makes wait(...) return right away.
+  listener->wake_up();
+  EXPECT_EQ(listener->wait(std::chrono::milliseconds(10000)),
+            NotificationWaitResult::Ready);
+
+  EXPECT_FALSE(listener->listen("my-chan", [](const Notification&) {}));
+}
+
+}  // namespace test_notification_listener
+
+#endif
+#endif
@@ -0,0 +1,70 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/postgres.hpp>
+#include <vector>
+#include "test_helpers.hpp"
+
+namespace test_prepared_statements {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+TEST(postgres, test_prepared_statements) {
+  const auto people1 = std::vector<Person>(
+      {Person{
+           .id = 0, .first_name = "Homer", .last_name = "Simpson", .age = 45},
+       Person{.id = 1, .first_name = "Bart", .last_name = "Simpson", .age = 10},
+       Person{.id = 2, .first_name = "Lisa", .last_name = "Simpson", .age = 8},
+       Person{
+           .id = 3, .first_name = "Maggie", .last_name = "Simpson", .age = 0}});
+
+  const auto credentials = sqlgen::postgres::test::make_credentials();
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn = sqlgen::postgres::connect(credentials)
+                        .and_then(drop<Person> | if_exists)
+                        .and_then(create_table<Person> | if_not_exists)
+                        .value();
+
+  for (const auto& person : people1) {
+    insert(conn, person).value();
+  }
+
+  // The INSERT is only prepared once.
+  const auto stats = conn->prepared_statement_stats();
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.hits, people1.size() - 1);
+  EXPECT_EQ(stats.size, 1);
+
+  // Once the statement no longer exists on the server, the first insert
+  // fails and the second one prepares it again.
+  conn->execute("DEALLOCATE ALL;").value();
+
+  const auto abe =
+      Person{.id = 4, .first_name = "Abe", .last_name = "Simpson", .age = 83};
+
+  EXPECT_FALSE(insert(conn, abe) && true);
+  insert(conn, abe).value();
+
+  EXPECT_EQ(conn->prepared_statement_stats().invalidations, 1);
+
+  const auto people2 =
+      sqlgen::read<std::vector<Person>>(conn).value();
+
+  EXPECT_EQ(people2.size(), 5);
+}
+
+}  // namespace test_prepared_statements
+
+#endif
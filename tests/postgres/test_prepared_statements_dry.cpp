@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+
+#include <sqlgen/postgres.hpp>
+
+namespace test_prepared_statements_dry {
+
+TEST(postgres, test_prepared_statements_dry) {
+  auto statements = sqlgen::postgres::PreparedStatements(2);
+
+  EXPECT_FALSE(statements.find("SELECT 1"));
+
+  const auto name1 = statements.make_name();
+  EXPECT_FALSE(statements.insert("SELECT 1", name1));
+
+  const auto name2 = statements.make_name();
+  EXPECT_NE(name1, name2);
+  EXPECT_FALSE(statements.insert("SELECT 2", name2));
+
+  // Makes "SELECT 2" the least recently used statement.
+  EXPECT_EQ(statements.find("SELECT 1"), name1);
+
+  const auto evicted = statements.insert("SELECT 3", statements.make_name());
+  EXPECT_EQ(evicted, name2);
+  EXPECT_FALSE(statements.find("SELECT 2"));
+
+  statements.invalidate("SELECT 1");
+  EXPECT_FALSE(statements.find("SELECT 1"));
+
+  const auto stats = statements.stats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 3);
+  EXPECT_EQ(stats.evictions, 1);
+  EXPECT_EQ(stats.invalidations, 1);
+  EXPECT_EQ(stats.size, 1);
+}
+
+}  // namespace test_prepared_statements_dry
@@ -0,0 +1,178 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <optional>
+#include <sqlgen/postgres.hpp>
+#include <vector>
+#include "test_helpers.hpp"
+
+namespace test_stream_reads {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+struct Missing {
+  int x;
+};
+
+struct OptionalAge {
+  static constexpr const char* tablename = "StreamAges";
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::optional<int> age;
+};
+
+struct RequiredAge {
+  static constexpr const char* tablename = "StreamAges";
+  sqlgen::PrimaryKey<uint32_t> id;
+  int age;
+};
+
+TEST(postgres, test_stream_reads) {
+  auto people1 = std::vector<Person>();
+  for (uint32_t i = 0; i < 100; ++i) {
+    people1.emplace_back(Person{.id = i,
+                                .first_name = "Person " + std::to_string(i),
+                                .last_name = "Simpson",
+                                .age = static_cast<int>(i)});
+  }
+
+  auto credentials = sqlgen::postgres::test::make_credentials();
+  credentials.fetch_size = 7;
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn = sqlgen::postgres::connect(credentials)
+                        .and_then(drop<Person> | if_exists)
+                        .and_then(create_table<Person> | if_not_exists)
+                        .and_then(insert(std::ref(people1)))
+                        .value();
+
+  // Reads into a vector do not end a transaction begun by the user.
+  conn->begin_transaction().value();
+
+  const auto people2 =
+      (sqlgen::read<std::vector<Person>> | order_by("id"_c))(conn).value();
+
+  EXPECT_EQ(rfl::json::write(people2), rfl::json::write(people1));
+
+  (delete_from<Person> | where("age"_c >= 50))(conn).value();
+
+  conn->rollback().value();
+
+  const auto people3 = sqlgen::read<std::vector<Person>>(conn).value();
+
+  EXPECT_EQ(people3.size(), 100);
+
+  // Errors in the query are reported by the read and leave the connection
+  // usable.
+  EXPECT_FALSE(sqlgen::read<std::vector<Missing>>(conn));
+
+  const auto people4 = (sqlgen::read<std::vector<Person>> |
+                        where("age"_c < 10) | order_by("id"_c))(conn)
+                           .value();
+
+  EXPECT_EQ(people4.size(), 10);
+}
+
+TEST(postgres, test_stream_ranges) {
+  auto people1 = std::vector<Person>();
+  for (uint32_t i = 0; i < 100; ++i) {
+    people1.emplace_back(Person{.id = i,
+                                .first_name = "Person " + std::to_string(i),
+                                .last_name = "Simpson",
+                                .age = static_cast<int>(i)});
+  }
+
+  auto credentials = sqlgen::postgres::test::make_credentials();
+  credentials.fetch_size = 10;
+  credentials.stream_ranges = true;
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn = sqlgen::postgres::connect(credentials)
+                        .and_then(drop<Person> | if_exists)
+                        .and_then(create_table<Person> | if_not_exists)
+                        .and_then(insert(std::ref(people1)))
+                        .value();
+
+  {
+    const auto range =
+        (sqlgen::read<sqlgen::Range<Person>> | order_by("id"_c))(conn)
+            .value();
+
+    auto people2 = std::vector<Person>();
+    for (const auto& person : range) {
+      people2.emplace_back(person.value());
+    }
+
+    EXPECT_EQ(rfl::json::write(people2), rfl::json::write(people1));
+  }
+
+  {
+    const auto range =
+        (sqlgen::read<sqlgen::Range<Person>> | order_by("id"_c))(conn)
+            .value();
+
+    // Abandoning the range cancels the rest of the query.
+    size_t count = 0;
+    for (auto it = range.begin(); it != range.end() && count < 5; ++it) {
+      ++count;
+    }
+    EXPECT_EQ(count, 5);
+  }
+
+  const auto people3 = sqlgen::read<std::vector<Person>>(conn).value();
+
+  EXPECT_EQ(people3.size(), 100);
+}
+
+TEST(postgres, test_stream_reads_in_transaction) {
+  auto ages = std::vector<OptionalAge>();
+  for (uint32_t i = 0; i < 100; ++i) {
+    ages.emplace_back(OptionalAge{
+        .id = i,
+        .age = i == 0 ? std::nullopt : std::make_optional<int>(i)});
+  }
+
+  auto credentials = sqlgen::postgres::test::make_credentials();
+  credentials.fetch_size = 7;
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn = sqlgen::postgres::connect(credentials)
+                        .and_then(drop<OptionalAge> | if_exists)
+                        .and_then(create_table<OptionalAge> | if_not_exists)
+                        .value();
+
+  const auto t = begin_transaction(conn).and_then(insert(std::ref(ages)));
+
+  // The NULL in the first row cannot be parsed, so the read stops before
+  // the rest of the rows have been received. That must not abort the
+  // transaction.
+  EXPECT_FALSE(
+      (sqlgen::read<std::vector<RequiredAge>> | order_by("id"_c))(t.value()));
+
+  const auto extra = std::vector<OptionalAge>(
+      {OptionalAge{.id = 100, .age = 100}});
+
+  t.and_then(insert(std::ref(extra))).and_then(commit).value();
+
+  const auto ages2 = sqlgen::read<std::vector<OptionalAge>>(conn).value();
+
+  EXPECT_EQ(ages2.size(), 101);
+}
+
+}  // namespace test_stream_reads
+
+#endif
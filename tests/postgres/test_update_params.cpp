@@ -0,0 +1,68 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/postgres.hpp>
+#include <vector>
+#include "test_helpers.hpp"
+
+namespace test_update_params {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+TEST(postgres, test_update_params) {
+  const auto people1 = std::vector<Person>(
+      {Person{
+           .id = 0, .first_name = "Homer", .last_name = "Simpson", .age = 45},
+       Person{.id = 1, .first_name = "Bart", .last_name = "Simpson", .age = 10},
+       Person{.id = 2, .first_name = "Lisa", .last_name = "Simpson", .age = 8},
+       Person{
+           .id = 3, .first_name = "Maggie", .last_name = "Simpson", .age = 0}});
+
+  const auto credentials = sqlgen::postgres::test::make_credentials();
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn = sqlgen::postgres::connect(credentials)
+                        .and_then(drop<Person> | if_exists)
+                        .and_then(create_table<Person> | if_not_exists)
+                        .value();
+
+  insert(conn, people1).value();
+
+  const auto before = conn->prepared_statement_stats();
+
+  // The updates only differ in their literals, so they share a single
+  // prepared statement.
+  for (const auto& person : people1) {
+    const auto query = update<Person>("last_name"_c.set("O'Brien"),
+                                      "age"_c.set(person.age + 1)) |
+                       where("first_name"_c == person.first_name);
+    query(conn).value();
+  }
+
+  const auto after = conn->prepared_statement_stats();
+  EXPECT_EQ(after.misses - before.misses, 1);
+  EXPECT_EQ(after.hits - before.hits, people1.size() - 1);
+
+  const auto people2 =
+      (sqlgen::read<std::vector<Person>> | order_by("id"_c))(conn).value();
+
+  const std::string expected =
+      R"([{"id":0,"first_name":"Homer","last_name":"O'Brien","age":46},{"id":1,"first_name":"Bart","last_name":"O'Brien","age":11},{"id":2,"first_name":"Lisa","last_name":"O'Brien","age":9},{"id":3,"first_name":"Maggie","last_name":"O'Brien","age":1}])";
+
+  EXPECT_EQ(rfl::json::write(people2), expected);
+}
+
+}  // namespace test_update_params
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/postgres.hpp>
+#include <vector>
+
+#include "test_helpers.hpp"
+
+namespace test_write_binary {
+
+enum class Role { parent, child };
+
+struct Address {
+  std::string street;
+  int number;
+};
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  int16_t age;
+  int64_t savings;
+  double height;
+  bool is_adult;
+  Role role;
+  std::optional<std::string> nickname;
+  sqlgen::JSON<Address> address;
+  sqlgen::Timestamp<"%Y-%m-%d %H:%M:%S"> ts;
+  sqlgen::Date birthday;
+};
+
+TEST(postgres, test_write_binary) {
+  const auto people1 = std::vector<Person>(
+      {Person{.id = 0,
+              .first_name = "Homer",
+              .age = 45,
+              .savings = -1234567890123,
+              .height = 1.83,
+              .is_adult = true,
+              .role = Role::parent,
+              .nickname = std::nullopt,
+              .address = Address{.street = "Evergreen Terrace", .number = 742},
+              .ts = "1999-12-31 23:59:59",
+              .birthday = "1956-05-12"},
+       Person{.id = 1,
+              .first_name = "Bart\twith a tab",
+              .age = 10,
+              .savings = 42,
+              .height = 0.000125,
+              .is_adult = false,
+              .role = Role::child,
+              .nickname = "El Barto",
+              .address = Address{.street = "Evergreen Terrace", .number = 742},
+              .ts = "2000-01-01 01:00:00",
+              .birthday = "1980-04-01"}});
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn = sqlgen::postgres::connect(postgres::test::make_credentials())
+                        .and_then(drop<Person> | if_exists);
+
+  const auto people2 =
+      conn.and_then(write(std::ref(people1)) | binary)
+          .and_then(sqlgen::read<std::vector<Person>> | order_by("id"_c))
+          .value();
+
+  EXPECT_EQ(rfl::json::write(people1), rfl::json::write(people2));
+}
+
+struct Counter {
+  uint16_t value;
+};
+
+TEST(postgres, test_write_binary_out_of_range) {
+  using namespace sqlgen;
+
+  const auto conn = sqlgen::postgres::connect(postgres::test::make_credentials())
+                        .and_then(drop<Counter> | if_exists);
+
+  // 40000 does not fit into a SMALLINT, so the whole COPY must be rejected.
+  const auto counters =
+      std::vector<Counter>({Counter{.value = 1}, Counter{.value = 40000}});
+
+  const auto res = conn.and_then(write(std::ref(counters)) | binary);
+
+  EXPECT_FALSE(res);
+
+  const auto counters2 = conn.and_then(sqlgen::read<std::vector<Counter>>);
+
+  EXPECT_TRUE(counters2);
+  EXPECT_EQ(counters2->size(), 0);
+}
+
+}  // namespace test_write_binary
+
+#endif
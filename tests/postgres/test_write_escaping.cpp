@@ -0,0 +1,49 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/postgres.hpp>
+#include <vector>
+
+#include "test_helpers.hpp"
+
+namespace test_write_escaping {
+
+struct Note {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::optional<std::string> text;
+};
+
+TEST(postgres, test_write_escaping) {
+  // These are written in the text format of COPY, which uses \t as the
+  // delimiter, \e for NULL and \a as the quote character.
+  const auto notes1 = std::vector<Note>(
+      {Note{.id = 0, .text = "with\ttab"},
+       Note{.id = 1, .text = "with\nline break"},
+       Note{.id = 2, .text = "with \a quote"},
+       Note{.id = 3, .text = "\e"},
+       Note{.id = 4, .text = ""},
+       Note{.id = 5, .text = std::nullopt},
+       Note{.id = 6, .text = "\a\t\a"}});
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn = postgres::connect(postgres::test::make_credentials())
+                        .and_then(drop<Note> | if_exists);
+
+  const auto notes2 =
+      sqlgen::write(conn, notes1)
+          .and_then(sqlgen::read<std::vector<Note>> | order_by("id"_c))
+          .value();
+
+  EXPECT_EQ(rfl::json::write(notes1), rfl::json::write(notes2));
+}
+
+}  // namespace test_write_escaping
+
+#endif
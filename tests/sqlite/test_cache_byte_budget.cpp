@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <string>
+#include <vector>
+
+namespace test_cache_byte_budget {
+
+struct User {
+  std::string name;
+  int age;
+};
+
+TEST(sqlite, test_cache_byte_budget) {
+  const auto conn = sqlgen::sqlite::connect();
+
+  auto users = std::vector<User>();
+  for (int i = 0; i < 100; ++i) {
+    users.push_back(User{.name = std::string(100, 'a' + i % 26), .age = i});
+  }
+
+  sqlgen::write(conn, users);
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto small_query = sqlgen::cache<100, 10000>(
+      sqlgen::read<std::vector<User>> | where("age"_c < 10));
+
+  EXPECT_EQ(small_query(conn).value().size(), 10);
+
+  const auto small_stats = small_query.stats(conn);
+
+  // The result holds ten strings with 100 characters each.
+  EXPECT_EQ(small_stats.size, 1);
+  EXPECT_GT(small_stats.bytes, 1000);
+  EXPECT_LT(small_stats.bytes, 10000);
+
+  // The result holds 100 strings with 100 characters each, so it exceeds the
+  // byte budget on its own and is not retained.
+  const auto large_query =
+      sqlgen::cache<100, 10000>(sqlgen::read<std::vector<User>>);
+
+  EXPECT_EQ(large_query(conn).value().size(), 100);
+
+  const auto large_stats = large_query.stats(conn);
+
+  EXPECT_EQ(large_stats.size, 0);
+  EXPECT_EQ(large_stats.bytes, 0);
+  EXPECT_EQ(large_stats.evictions, 1);
+}
+
+}  // namespace test_cache_byte_budget
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <thread>
+#include <vector>
+
+namespace test_cache_invalidation {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  int age;
+};
+
+TEST(sqlite, test_cache_invalidation) {
+  const auto conn = sqlgen::sqlite::connect();
+
+  const auto people = std::vector<Person>(
+      {Person{.id = 0, .first_name = "Homer", .age = 45},
+       Person{.id = 1, .first_name = "Bart", .age = 10}});
+
+  sqlgen::write(conn, people);
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto cached_query =
+      sqlgen::cache<100>(sqlgen::read<Person> | where("first_name"_c == "Bart"));
+
+  EXPECT_EQ(cached_query(conn).value().age, 10);
+  EXPECT_EQ(cached_query(conn).value().age, 10);
+  EXPECT_EQ(cached_query.stats(conn).misses, 1);
+
+  const auto update_query =
+      update<Person>("age"_c.set(11)) | where("first_name"_c == "Bart");
+
+  update_query(conn).value();
+
+  EXPECT_EQ(cached_query.cache(conn).size(), 0);
+  EXPECT_EQ(cached_query(conn).value().age, 11);
+
+  sqlgen::insert(conn, Person{.id = 2, .first_name = "Lisa", .age = 8})
+      .value();
+
+  EXPECT_EQ(cached_query.cache(conn).size(), 0);
+  EXPECT_EQ(cached_query(conn).value().age, 11);
+
+  sqlgen::invalidate_cache<Person>();
+
+  EXPECT_EQ(cached_query.cache(conn).size(), 0);
+
+  const auto stats = cached_query.stats(conn);
+
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 3);
+  EXPECT_EQ(stats.invalidations, 3);
+}
+
+TEST(sqlite, test_cache_ttl) {
+  const auto conn = sqlgen::sqlite::connect();
+
+  sqlgen::write(conn, Person{.id = 0, .first_name = "Homer", .age = 45});
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto cached_query =
+      sqlgen::cache<100>(sqlgen::read<Person> | where("age"_c > 40),
+                         std::chrono::milliseconds(50));
+
+  EXPECT_EQ(cached_query(conn).value().age, 45);
+  EXPECT_EQ(cached_query(conn).value().age, 45);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  EXPECT_EQ(cached_query(conn).value().age, 45);
+
+  const auto stats = cached_query.stats(conn);
+
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 2);
+  EXPECT_EQ(stats.invalidations, 1);
+}
+
+}  // namespace test_cache_invalidation
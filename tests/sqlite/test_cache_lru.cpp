@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <string>
+#include <vector>
+
+namespace test_cache_lru {
+
+struct User {
+  std::string name;
+  int age;
+};
+
+TEST(sqlite, test_cache_lru) {
+  const auto conn = sqlgen::sqlite::connect();
+
+  const auto users = std::vector<User>({User{.name = "John", .age = 30},
+                                        User{.name = "Jane", .age = 25}});
+  sqlgen::write(conn, users);
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto query = [](const std::string& _name) {
+    return sqlgen::cache<1>(sqlgen::read<User> | where("name"_c == _name));
+  };
+
+  const auto john1 = query("John")(conn).value();
+  const auto john2 = query("John")(conn).value();
+
+  EXPECT_EQ(john1.age, 30);
+  EXPECT_EQ(john2.age, 30);
+  EXPECT_EQ(query("John").stats(conn).hits, 1);
+  EXPECT_EQ(query("John").stats(conn).misses, 1);
+
+  // Evicts the result for John, because the cache can only hold one entry.
+  const auto jane = query("Jane")(conn).value();
+  const auto john3 = query("John")(conn).value();
+
+  EXPECT_EQ(jane.age, 25);
+  EXPECT_EQ(john3.age, 30);
+
+  const auto stats = query("John").stats(conn);
+
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 3);
+  EXPECT_EQ(stats.evictions, 2);
+  EXPECT_EQ(stats.size, 1);
+}
+
+TEST(sqlite, test_cache_lru_two_entries) {
+  const auto conn = sqlgen::sqlite::connect();
+
+  const auto users = std::vector<User>({User{.name = "John", .age = 30},
+                                        User{.name = "Jane", .age = 25},
+                                        User{.name = "Jim", .age = 40}});
+  sqlgen::write(conn, users);
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto query = [](const std::string& _name) {
+    return sqlgen::cache<2>(sqlgen::read<User> | where("name"_c == _name));
+  };
+
+  // Both results fit into the cache, regardless of the hash of their SQL.
+  query("John")(conn).value();
+  query("Jane")(conn).value();
+  query("John")(conn).value();
+  query("Jane")(conn).value();
+
+  auto stats = query("John").stats(conn);
+
+  EXPECT_EQ(stats.hits, 2);
+  EXPECT_EQ(stats.misses, 2);
+  EXPECT_EQ(stats.evictions, 0);
+  EXPECT_EQ(stats.size, 2);
+
+  // Evicts the result for Jane, which is the least recently used.
+  query("Jim")(conn).value();
+  query("John")(conn).value();
+
+  stats = query("John").stats(conn);
+
+  EXPECT_EQ(stats.hits, 3);
+  EXPECT_EQ(stats.misses, 3);
+  EXPECT_EQ(stats.evictions, 1);
+  EXPECT_EQ(stats.size, 2);
+}
+
+}  // namespace test_cache_lru
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <string>
+#include <vector>
+
+namespace test_cache_transaction {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  int age;
+};
+
+void remove_files() {
+  for (const auto suffix : {"", "-wal", "-shm"}) {
+    std::remove((std::string("test_cache_transaction.db") + suffix).c_str());
+  }
+}
+
+TEST(sqlite, test_cache_transaction) {
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  remove_files();
+
+  const auto config =
+      sqlite::Config::high_throughput("test_cache_transaction.db");
+
+  const auto people =
+      std::vector<Person>({Person{.id = 0, .first_name = "Homer", .age = 45},
+                           Person{.id = 1, .first_name = "Bart", .age = 10}});
+
+  {
+    const auto conn1 =
+        sqlite::connect(config).and_then(write(std::ref(people))).value();
+
+    const auto conn2 = sqlite::connect(config).value();
+
+    const auto bart =
+        cache<100>(read<Person> | where("first_name"_c == "Bart"));
+
+    EXPECT_EQ(bart(conn2).value().age, 10);
+
+    const auto t =
+        begin_transaction(conn1)
+            .and_then(update<Person>("age"_c.set(11)) |
+                      where("first_name"_c == "Bart"))
+            .value();
+
+    // The update is not visible to the second connection before the
+    // transaction is committed, so the cached result must not be replaced
+    // by a fresh read of the old value.
+    EXPECT_EQ(bart(conn2).value().age, 10);
+    EXPECT_EQ(bart.stats(conn2).invalidations, 0);
+
+    commit(t).value();
+
+    EXPECT_EQ(bart(conn2).value().age, 11);
+    EXPECT_EQ(bart.stats(conn2).invalidations, 1);
+
+    // A rolled back transaction leaves the cached result untouched.
+    begin_transaction(conn1)
+        .and_then(update<Person>("age"_c.set(12)) |
+                  where("first_name"_c == "Bart"))
+        .and_then(rollback)
+        .value();
+
+    EXPECT_EQ(bart(conn2).value().age, 11);
+
+    const auto stats = bart.stats(conn2);
+
+    EXPECT_EQ(stats.hits, 2);
+    EXPECT_EQ(stats.misses, 2);
+    EXPECT_EQ(stats.invalidations, 1);
+  }
+
+  remove_files();
+}
+
+}  // namespace test_cache_transaction
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <vector>
+
+namespace test_config {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+TEST(sqlite, test_config) {
+  const auto people1 = std::vector<Person>(
+      {Person{
+           .id = 0, .first_name = "Homer", .last_name = "Simpson", .age = 45},
+       Person{.id = 1, .first_name = "Bart", .last_name = "Simpson", .age = 10},
+       Person{.id = 2, .first_name = "Lisa", .last_name = "Simpson", .age = 8},
+       Person{
+           .id = 3, .first_name = "Maggie", .last_name = "Simpson", .age = 0}});
+
+  const auto config =
+      sqlgen::sqlite::Config::high_throughput("test_config.db");
+
+  {
+    const auto conn = sqlgen::sqlite::connect(config)
+                          .and_then(sqlgen::write(std::ref(people1)))
+                          .value();
+
+    // In WAL mode, the changes are appended to a separate file, which exists
+    // as long as the connection is open.
+    EXPECT_TRUE(std::filesystem::exists("test_config.db-wal"));
+
+    const auto people2 = sqlgen::read<std::vector<Person>>(conn).value();
+
+    EXPECT_EQ(rfl::json::write(people2), rfl::json::write(people1));
+  }
+
+  // A connection with the default settings can read the data as well.
+  const auto people3 = sqlgen::sqlite::connect("test_config.db")
+                           .and_then(sqlgen::read<std::vector<Person>>)
+                           .value();
+
+  std::remove("test_config.db");
+
+  EXPECT_EQ(rfl::json::write(people3), rfl::json::write(people1));
+}
+
+TEST(sqlite, test_config_errors) {
+  // Without SQLITE_OPEN_CREATE, the database must already exist.
+  EXPECT_FALSE(sqlgen::sqlite::connect(sqlgen::sqlite::Config{
+      .fname = "test_config_missing.db", .flags = SQLITE_OPEN_READWRITE}));
+
+  EXPECT_FALSE(std::filesystem::exists("test_config_missing.db"));
+}
+
+}  // namespace test_config
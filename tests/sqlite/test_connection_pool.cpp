@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <optional>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <thread>
+
+namespace test_connection_pool {
+
+TEST(sqlite, test_connection_pool) {
+  const auto pool_config = sqlgen::ConnectionPoolConfig{.size = 1};
+
+  auto pool = sqlgen::make_connection_pool<sqlgen::sqlite::Connection>(
+                  pool_config, ":memory:")
+                  .value();
+
+  auto sess1 = std::make_optional(pool.acquire().value());
+
+  EXPECT_EQ(pool.available(), 0);
+
+  EXPECT_FALSE(pool.acquire(std::chrono::milliseconds(10)) && true);
+  EXPECT_EQ(pool.stats().num_timeouts, 1);
+
+  auto releaser = std::thread([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    sess1.reset();
+  });
+
+  const auto sess2 = pool.acquire(std::chrono::seconds(10));
+
+  releaser.join();
+
+  EXPECT_TRUE(sess2 && true);
+  EXPECT_EQ(pool.available(), 0);
+  EXPECT_EQ(pool.stats().num_waits, 2);
+  EXPECT_EQ(pool.stats().num_timeouts, 1);
+  EXPECT_GE(pool.stats().max_wait_time, std::chrono::milliseconds(10));
+}
+
+TEST(sqlite, test_connection_pool_sessions) {
+  const auto pool_config = sqlgen::ConnectionPoolConfig{.size = 2};
+
+  auto sess = std::optional<sqlgen::Ref<
+      sqlgen::Session<sqlgen::sqlite::Connection>>>();
+
+  {
+    auto pool1 = sqlgen::make_connection_pool<sqlgen::sqlite::Connection>(
+                     pool_config, ":memory:")
+                     .value();
+
+    auto pool2 = sqlgen::make_connection_pool<sqlgen::sqlite::Connection>(
+                     pool_config, ":memory:")
+                     .value();
+
+    // The same thread alternates between two pools.
+    for (int i = 0; i < 10; ++i) {
+      const auto sess1 = pool1.acquire().value();
+      const auto sess2 = pool2.acquire().value();
+      EXPECT_EQ(pool1.available(), 1);
+      EXPECT_EQ(pool2.available(), 1);
+    }
+
+    EXPECT_EQ(pool1.available(), 2);
+    EXPECT_EQ(pool2.available(), 2);
+
+    sess = pool1.acquire().value();
+  }
+
+  // The session outlives its pool and still releases its slot safely.
+  EXPECT_TRUE(sess && (*sess)->execute("SELECT 1;"));
+  sess.reset();
+}
+
+}  // namespace test_connection_pool
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <thread>
+
+namespace test_connection_pool_elastic {
+
+TEST(sqlite, test_connection_pool_elastic) {
+  const auto pool_config =
+      sqlgen::ConnectionPoolConfig{.min_size = 1,
+                                   .max_size = 3,
+                                   .idle_timeout = std::chrono::milliseconds(20)};
+
+  auto pool = sqlgen::make_connection_pool<sqlgen::sqlite::Connection>(
+                  pool_config, ":memory:")
+                  .value();
+
+  EXPECT_EQ(pool.size(), 1);
+  EXPECT_EQ(pool.max_size(), 3);
+
+  {
+    const auto sess1 = pool.acquire().value();
+    const auto sess2 = pool.acquire().value();
+    const auto sess3 = pool.acquire().value();
+
+    EXPECT_EQ(pool.size(), 3);
+    EXPECT_EQ(pool.available(), 0);
+    EXPECT_FALSE(pool.acquire(std::chrono::milliseconds(10)) && true);
+  }
+
+  EXPECT_EQ(pool.available(), 3);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  EXPECT_EQ(pool.size(), 1);
+  EXPECT_EQ(pool.available(), 1);
+}
+
+}  // namespace test_connection_pool_elastic
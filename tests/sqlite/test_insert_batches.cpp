@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/dynamic/Insert.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <sqlgen/transpilation/to_insert_or_write.hpp>
+#include <vector>
+
+namespace test_insert_batches {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  std::optional<int> age;
+};
+
+TEST(sqlite, test_insert_batches_to_sql) {
+  auto insert_stmt =
+      sqlgen::transpilation::to_insert_or_write<Person,
+                                                sqlgen::dynamic::Insert>();
+  insert_stmt.num_rows = 3;
+
+  const auto expected =
+      R"(INSERT INTO "Person" ("id", "first_name", "last_name", "age") VALUES (?, ?, ?, ?), (?, ?, ?, ?), (?, ?, ?, ?);)";
+
+  EXPECT_EQ(sqlgen::sqlite::connect().value()->to_sql(insert_stmt), expected);
+}
+
+TEST(sqlite, test_insert_batches) {
+  // Not a multiple of the number of rows per statement, so there is a
+  // remainder.
+  auto people1 = std::vector<Person>();
+  for (uint32_t i = 0; i < 1234; ++i) {
+    people1.emplace_back(
+        Person{.id = i,
+               .first_name = "Person " + std::to_string(i),
+               .last_name = "Simpson",
+               .age = i % 3 == 0 ? std::nullopt : std::make_optional<int>(i)});
+  }
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto people2 =
+      sqlite::connect()
+          .and_then(create_table<Person> | if_not_exists)
+          .and_then(insert(std::ref(people1)))
+          .and_then(sqlgen::read<std::vector<Person>> | order_by("id"_c))
+          .value();
+
+  EXPECT_EQ(rfl::json::write(people2), rfl::json::write(people1));
+
+  const auto people3 =
+      sqlite::connect()
+          .and_then(write(std::ref(people1)))
+          .and_then(sqlgen::read<std::vector<Person>> | order_by("id"_c))
+          .value();
+
+  EXPECT_EQ(rfl::json::write(people3), rfl::json::write(people1));
+
+  // A row that violates a constraint makes the statement it belongs to fail.
+  auto people4 = people1;
+  people4.back().id = 0;
+
+  EXPECT_FALSE(sqlite::connect()
+                   .and_then(create_table<Person> | if_not_exists)
+                   .and_then(insert(std::ref(people4))));
+}
+
+}  // namespace test_insert_batches
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <vector>
+
+namespace test_prepared_statements {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+TEST(sqlite, test_prepared_statements) {
+  auto people1 = std::vector<Person>();
+  for (uint32_t i = 0; i < 10; ++i) {
+    people1.emplace_back(Person{.id = i,
+                                .first_name = "Person " + std::to_string(i),
+                                .last_name = "Simpson",
+                                .age = static_cast<int>(i)});
+  }
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn = sqlite::connect()
+                        .and_then(create_table<Person> | if_not_exists)
+                        .and_then(insert(std::ref(people1)))
+                        .value();
+
+  const auto stats1 = conn->prepared_statement_stats();
+
+  // The literals are bound, so all of the lookups share one statement.
+  for (uint32_t i = 0; i < 10; ++i) {
+    const auto people2 =
+        (sqlgen::read<std::vector<Person>> | where("id"_c == i))(conn).value();
+    ASSERT_EQ(people2.size(), 1);
+    EXPECT_EQ(people2.at(0).first_name, "Person " + std::to_string(i));
+  }
+
+  const auto stats2 = conn->prepared_statement_stats();
+
+  EXPECT_EQ(stats2.misses - stats1.misses, 1);
+  EXPECT_EQ(stats2.hits - stats1.hits, 9);
+
+  {
+    const auto range =
+        (sqlgen::read<sqlgen::Range<Person>> | order_by("id"_c))(conn).value();
+
+    // The statement of the range is in use, so the same query needs a
+    // statement of its own.
+    const auto people3 =
+        (sqlgen::read<std::vector<Person>> | order_by("id"_c))(conn).value();
+
+    auto people4 = std::vector<Person>();
+    for (const auto& person : range) {
+      people4.emplace_back(person.value());
+    }
+
+    EXPECT_EQ(rfl::json::write(people3), rfl::json::write(people1));
+    EXPECT_EQ(rfl::json::write(people4), rfl::json::write(people1));
+  }
+
+  {
+    const auto range =
+        (sqlgen::read<sqlgen::Range<Person>> | order_by("id"_c))(conn).value();
+
+    // Abandon the range half way through.
+    size_t count = 0;
+    for (auto it = range.begin(); it != range.end() && count < 5; ++it) {
+      ++count;
+    }
+    EXPECT_EQ(count, 5);
+  }
+
+  // The abandoned statement must not keep the table locked.
+  drop<Person>(conn).value();
+}
+
+TEST(sqlite, test_prepared_statements_disabled) {
+  const auto people1 = std::vector<Person>(
+      {Person{
+           .id = 0, .first_name = "Homer", .last_name = "Simpson", .age = 45},
+       Person{
+           .id = 1, .first_name = "Bart", .last_name = "Simpson", .age = 10}});
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto people2 =
+      sqlite::connect(":memory:", 0)
+          .and_then(write(std::ref(people1)))
+          .and_then(sqlgen::read<std::vector<Person>> | order_by("id"_c))
+          .value();
+
+  EXPECT_EQ(rfl::json::write(people2), rfl::json::write(people1));
+}
+
+}  // namespace test_prepared_statements
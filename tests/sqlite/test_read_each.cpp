@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <vector>
+
+namespace test_read_each {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+TEST(sqlite, test_read_each) {
+  auto people = std::vector<Person>();
+  for (uint32_t i = 0; i < 1000; ++i) {
+    people.emplace_back(Person{.id = i,
+                               .first_name = "Person " + std::to_string(i),
+                               .last_name = i % 2 == 0 ? "Simpson" : "Flanders",
+                               .age = static_cast<int>(i % 90)});
+  }
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn = sqlgen::sqlite::connect().and_then(write(std::ref(people)));
+
+  long total_age = 0;
+  size_t count = 0;
+
+  read_each<Person>(conn, [&](Person&& _person) {
+    total_age += _person.age;
+    ++count;
+  }).value();
+
+  long expected_age = 0;
+  for (const auto& person : people) {
+    expected_age += person.age;
+  }
+
+  EXPECT_EQ(count, 1000);
+  EXPECT_EQ(total_age, expected_age);
+
+  std::vector<uint32_t> ids;
+
+  const auto query =
+      read_each<Person>([&](const Person& _person) {
+        ids.push_back(_person.id());
+      }) |
+      where("last_name"_c == "Flanders") | order_by("id"_c.desc()) | limit(3);
+
+  query(conn).value();
+
+  EXPECT_EQ(ids, std::vector<uint32_t>({999, 997, 995}));
+}
+
+}  // namespace test_read_each
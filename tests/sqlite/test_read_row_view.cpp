@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <string>
+#include <vector>
+
+namespace test_read_row_view {
+
+struct Document {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string title;
+  std::optional<std::string> body;
+  double score;
+  int64_t views;
+};
+
+TEST(sqlite, test_read_row_view) {
+  // The values are parsed straight from the buffers of sqlite, so we make
+  // sure that long strings, empty strings and NULL values survive this.
+  const auto docs1 = std::vector<Document>(
+      {Document{.id = 0,
+                .title = "Short",
+                .body = std::string(1000, 'a'),
+                .score = 0.125,
+                .views = 9007199254740993},
+       Document{.id = 1,
+                .title = "Empty",
+                .body = std::string(),
+                .score = -1.5e10,
+                .views = -42},
+       Document{.id = 2,
+                .title = "Null",
+                .body = std::nullopt,
+                .score = 3.0,
+                .views = 0}});
+
+  using namespace sqlgen;
+
+  const auto docs2 = sqlite::connect()
+                         .and_then(write(std::ref(docs1)))
+                         .and_then(sqlgen::read<std::vector<Document>>)
+                         .value();
+
+  EXPECT_EQ(rfl::json::write(docs1), rfl::json::write(docs2));
+}
+
+}  // namespace test_read_row_view
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdio>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace test_read_write_pool {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+void remove_files() {
+  for (const auto suffix : {"", "-wal", "-shm"}) {
+    std::remove((std::string("test_read_write_pool.db") + suffix).c_str());
+  }
+}
+
+TEST(sqlite, test_read_write_pool) {
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  remove_files();
+
+  {
+    auto pool = sqlite::ReadWritePool::make(
+                    ConnectionPoolConfig{.size = 4},
+                    sqlite::Config::high_throughput("test_read_write_pool.db"))
+                    .value();
+
+    pool.writer().and_then(create_table<Person> | if_not_exists).value();
+
+    // Readers cannot write.
+    EXPECT_FALSE(pool.reader().and_then(drop<Person>));
+
+    const size_t num_writers = 4;
+    const uint32_t rows_per_writer = 50;
+
+    std::atomic<bool> done = false;
+    std::atomic<size_t> num_reads = 0;
+    std::atomic<size_t> num_errors = 0;
+
+    auto readers = std::vector<std::thread>();
+    for (size_t i = 0; i < 4; ++i) {
+      readers.emplace_back([&]() {
+        while (!done) {
+          const auto people =
+              pool.reader().and_then(sqlgen::read<std::vector<Person>>);
+          if (people) {
+            ++num_reads;
+          } else {
+            ++num_errors;
+          }
+        }
+      });
+    }
+
+    // The writers share a single connection, so they are never busy.
+    auto writers = std::vector<std::thread>();
+    for (size_t i = 0; i < num_writers; ++i) {
+      writers.emplace_back([&, i]() {
+        for (uint32_t j = 0; j < rows_per_writer; ++j) {
+          const auto id = static_cast<uint32_t>(i) * rows_per_writer + j;
+          const auto people = std::vector<Person>(
+              {Person{.id = id,
+                      .first_name = "Bart",
+                      .last_name = "Simpson",
+                      .age = 10}});
+          if (!pool.writer().and_then(insert(std::ref(people)))) {
+            ++num_errors;
+          }
+        }
+      });
+    }
+
+    for (auto& t : writers) {
+      t.join();
+    }
+
+    done = true;
+
+    for (auto& t : readers) {
+      t.join();
+    }
+
+    EXPECT_EQ(num_errors, 0);
+    EXPECT_GT(num_reads, 0);
+
+    const auto people =
+        pool.reader().and_then(sqlgen::read<std::vector<Person>>).value();
+
+    EXPECT_EQ(people.size(), num_writers * rows_per_writer);
+  }
+
+  remove_files();
+
+  // The readers would not see the writes to an in-memory database.
+  EXPECT_FALSE(sqlite::ReadWritePool::make(ConnectionPoolConfig{.size = 2},
+                                           sqlite::Config{}));
+}
+
+}  // namespace test_read_write_pool
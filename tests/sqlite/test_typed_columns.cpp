@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <optional>
+#include <rfl.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <string>
+#include <vector>
+
+namespace test_typed_columns {
+
+enum class Color { red, green, blue };
+
+struct Measurement {
+  sqlgen::PrimaryKey<int64_t> id;
+  double value;
+  float ratio;
+  bool valid;
+  std::optional<int32_t> count;
+  Color color;
+  std::string label;
+};
+
+TEST(sqlite, test_typed_columns) {
+  // The numbers are read with sqlite3_column_int64 and sqlite3_column_double
+  // and everything else as text, so we make sure that all of them survive.
+  const auto measurements1 = std::vector<Measurement>(
+      {Measurement{.id = INT64_MAX,
+                   .value = 0.125,
+                   .ratio = 0.25f,
+                   .valid = true,
+                   .count = 7,
+                   .color = Color::green,
+                   .label = "first"},
+       Measurement{.id = INT64_MIN,
+                   .value = -1.5e10,
+                   .ratio = -2.5f,
+                   .valid = false,
+                   .count = std::nullopt,
+                   .color = Color::blue,
+                   .label = ""}});
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto measurements2 =
+      sqlite::connect()
+          .and_then(write(std::ref(measurements1)))
+          .and_then(sqlgen::read<std::vector<Measurement>> |
+                    order_by("id"_c.desc()))
+          .value();
+
+  ASSERT_EQ(measurements2.size(), 2);
+
+  for (size_t i = 0; i < 2; ++i) {
+    const auto& m1 = measurements1.at(i);
+    const auto& m2 = measurements2.at(i);
+    EXPECT_EQ(m1.id(), m2.id());
+    EXPECT_EQ(m1.value, m2.value);
+    EXPECT_EQ(m1.ratio, m2.ratio);
+    EXPECT_EQ(m1.valid, m2.valid);
+    EXPECT_EQ(m1.count, m2.count);
+    EXPECT_EQ(m1.color, m2.color);
+    EXPECT_EQ(m1.label, m2.label);
+  }
+}
+
+struct WideInteger {
+  static constexpr const char* tablename = "Numbers";
+  int64_t value;
+};
+
+struct NarrowInteger {
+  static constexpr const char* tablename = "Numbers";
+  int8_t value;
+};
+
+struct Real {
+  static constexpr const char* tablename = "Reals";
+  double value;
+};
+
+struct RealAsInteger {
+  static constexpr const char* tablename = "Reals";
+  int32_t value;
+};
+
+TEST(sqlite, test_typed_columns_out_of_range) {
+  using namespace sqlgen;
+
+  const auto conn = sqlite::connect().value();
+
+  // SQLite stores all integers as 64-bit integers, which must not wrap
+  // around when they are read into narrower fields.
+  write(conn, std::vector<WideInteger>({WideInteger{.value = 127}})).value();
+
+  EXPECT_EQ(sqlgen::read<std::vector<NarrowInteger>>(conn).value().at(0).value,
+            127);
+
+  write(conn, std::vector<WideInteger>({WideInteger{.value = 300}})).value();
+
+  EXPECT_FALSE(sqlgen::read<std::vector<NarrowInteger>>(conn));
+
+  // Reals are truncated towards zero when they are read into integer fields,
+  // as long as the result is in range.
+  write(conn, std::vector<Real>({Real{.value = -4.7}})).value();
+
+  EXPECT_EQ(sqlgen::read<std::vector<RealAsInteger>>(conn).value().at(0).value,
+            -4);
+
+  write(conn, std::vector<Real>({Real{.value = 1e30}})).value();
+
+  EXPECT_FALSE(sqlgen::read<std::vector<RealAsInteger>>(conn));
+}
+
+}  // namespace test_typed_columns
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <vector>
+
+namespace test_where_params {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  double weight;
+};
+
+TEST(sqlite, test_where_params) {
+  const auto people1 = std::vector<Person>(
+      {Person{.id = 0,
+              .first_name = "Homer",
+              .last_name = "Simpson",
+              .weight = 1.0 / 3.0},
+       Person{.id = 1,
+              .first_name = "Bart",
+              .last_name = "Simpson",
+              .weight = 2.0 / 3.0},
+       Person{.id = 2,
+              .first_name = "Lisa",
+              .last_name = "Simpson",
+              .weight = 1.0}});
+
+  const auto conn = sqlgen::sqlite::connect();
+
+  sqlgen::write(conn, people1);
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  // The literals are bound as parameters, so neither the quote nor the
+  // precision of the floating point numbers get lost.
+  const auto update_query = update<Person>("last_name"_c.set("O'Brien")) |
+                            where("weight"_c == 1.0 / 3.0);
+
+  update_query(conn).value();
+
+  const auto people2 = sqlgen::read<std::vector<Person>> |
+                       where("last_name"_c == "O'Brien");
+
+  const auto obriens = people2(conn).value();
+
+  ASSERT_EQ(obriens.size(), 1);
+  EXPECT_EQ(obriens.at(0).first_name, "Homer");
+
+  const auto delete_query =
+      delete_from<Person> | where("last_name"_c.like("O'%") or
+                                  "weight"_c == 2.0 / 3.0);
+
+  delete_query(conn).value();
+
+  const auto people3 = sqlgen::read<std::vector<Person>>(conn).value();
+
+  ASSERT_EQ(people3.size(), 1);
+  EXPECT_EQ(people3.at(0).first_name, "Lisa");
+}
+
+}  // namespace test_where_params